@@ -12,49 +12,56 @@
 
 namespace mse {
 
-	template<class _Ty, class _A = std::allocator<_Ty> >
+	/* _TRefCount is the reference count policy of the (shared) msevector. msevector_single_threaded_reference_count avoids
+	atomic reference count updates when the ivector and its ipointers are only used from one thread. */
+	template<class _Ty, class _A = std::allocator<_Ty>, class _TRefCount = msevector_atomic_reference_count>
 	class ivector {
 	public:
-		typedef ivector<_Ty, _A> _Myt;
+		typedef ivector<_Ty, _A, _TRefCount> _Myt;
 		typedef msevector<_Ty, _A> _MV;
+		typedef TRefCountedMsevectorPtr<_MV, _TRefCount> _MVPtr;
 
-		msevector<_Ty, _A>& msevector() const { return (*m_shptr); }
+		msevector<_Ty, _A>& msevector() { return (*shptr()); }
+		const _MV& msevector() const { return const_msevector(); }
 		operator _MV() { return msevector(); }
 
-		explicit ivector(const _A& _Al = _A()) : m_shptr(new _MV(_Al)) {}
-		explicit ivector(size_t _N, const _Ty& _V = _Ty(), const _A& _Al = _A()) : m_shptr(new _MV(_N, _V, _Al)) {}
-		ivector(_MV&& _X) : m_shptr(new _MV(std::move(_X))) {}
-		ivector(const _MV& _X) : m_shptr(new _MV(_X)) {}
-		ivector(_Myt&& _X) : m_shptr(new _MV(std::move(_X.msevector()))) {}
-		ivector(const _Myt& _X) : m_shptr(new _MV(_X.msevector())) {}
+		explicit ivector(const _A& _Al = _A()) : m_shptr(_MV(_Al)) {}
+		explicit ivector(size_t _N, const _Ty& _V = _Ty(), const _A& _Al = _A()) : m_shptr(_MV(_N, _V, _Al)) {}
+		ivector(_MV&& _X) : m_shptr(std::move(_X)) {}
+		ivector(const _MV& _X) : m_shptr(_MV(_X)) {}
+		/* Moves just hand over the (reference counted) msevector, so they're constant time and don't allocate. Outstanding
+		ipointers (and the elements they reference) go with it. The moved-from ivector is left empty. (It gets a new msevector
+		when it's next modified, or a cipointer to it is obtained.) */
+		ivector(_Myt&& _X) MSE_MSEVECTOR_MOVE_NOEXCEPT : m_shptr(std::move(_X.m_shptr)) {}
+		ivector(const _Myt& _X) : m_shptr(_MV(_X.msevector())) {}
 		typedef typename _MV::const_iterator _It;
-		ivector(_It _F, _It _L, const _A& _Al = _A()) : m_shptr(new _MV(_F, _L, _Al)) {}
+		ivector(_It _F, _It _L, const _A& _Al = _A()) : m_shptr(_MV(_F, _L, _Al)) {}
 		template<class _Iter
 #ifndef MSVC2010_COMPATIBILE
 			, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type
 #endif /*MSVC2010_COMPATIBILE*/
 		>
-		ivector(_Iter _First, _Iter _Last) : m_shptr(new _MV(_First, _Last)) {}
+		ivector(_Iter _First, _Iter _Last) : m_shptr(_MV(_First, _Last)) {}
 
-		_Myt& operator=(_MV&& _X) { m_shptr->operator=(std::move(_X)); return (*this); }
-		_Myt& operator=(const _MV& _X) { m_shptr->operator=(_X); return (*this); }
-		_Myt& operator=(_Myt&& _X) { m_shptr->operator=(std::move(_X.msevector())); return (*this); }
-		_Myt& operator=(const _Myt& _X) { m_shptr->operator=(_X.msevector()); return (*this); }
-		void reserve(size_t _Count) { m_shptr->reserve(_Count); }
-		void resize(size_t _N, const _Ty& _X = _Ty()) { m_shptr->resize(_N, _X); }
-		typename _MV::const_reference operator[](size_t _P) const { return m_shptr->operator[](_P); }
-		typename _MV::reference operator[](size_t _P) { return m_shptr->operator[](_P); }
-		void push_back(_Ty&& _X) { m_shptr->push_back(std::move(_X)); }
-		void push_back(const _Ty& _X) { m_shptr->push_back(_X); }
-		void pop_back() { m_shptr->pop_back(); }
-		void assign(_It _F, _It _L) { m_shptr->assign(_F, _L); }
-		void assign(size_t _N, const _Ty& _X = _Ty()) { m_shptr->assign(_N, _X); }
-		typename _MV::iterator insert(typename _MV::iterator _P, _Ty&& _X) { return m_shptr->insert(_P, std::move(_X)); }
-		typename _MV::iterator insert(typename _MV::iterator _P, const _Ty& _X = _Ty()) { return m_shptr->insert(_P, _X); }
-		typename _MV::iterator insert(typename _MV::iterator _P, size_t _M, const _Ty& _X) { return m_shptr->insert(_P, _M, _X); }
+		_Myt& operator=(_MV&& _X) { shptr()->operator=(std::move(_X)); return (*this); }
+		_Myt& operator=(const _MV& _X) { shptr()->operator=(_X); return (*this); }
+		_Myt& operator=(_Myt&& _X) MSE_MSEVECTOR_MOVE_NOEXCEPT { m_shptr = std::move(_X.m_shptr); return (*this); }
+		_Myt& operator=(const _Myt& _X) { shptr()->operator=(_X.msevector()); return (*this); }
+		void reserve(size_t _Count) { shptr()->reserve(_Count); }
+		void resize(size_t _N, const _Ty& _X = _Ty()) { shptr()->resize(_N, _X); }
+		typename _MV::const_reference operator[](size_t _P) const { return const_msevector().operator[](_P); }
+		typename _MV::reference operator[](size_t _P) { return shptr()->operator[](_P); }
+		void push_back(_Ty&& _X) { shptr()->push_back(std::move(_X)); }
+		void push_back(const _Ty& _X) { shptr()->push_back(_X); }
+		void pop_back() { shptr()->pop_back(); }
+		void assign(_It _F, _It _L) { shptr()->assign(_F, _L); }
+		void assign(size_t _N, const _Ty& _X = _Ty()) { shptr()->assign(_N, _X); }
+		typename _MV::iterator insert(typename _MV::iterator _P, _Ty&& _X) { return shptr()->insert(_P, std::move(_X)); }
+		typename _MV::iterator insert(typename _MV::iterator _P, const _Ty& _X = _Ty()) { return shptr()->insert(_P, _X); }
+		typename _MV::iterator insert(typename _MV::iterator _P, size_t _M, const _Ty& _X) { return shptr()->insert(_P, _M, _X); }
 		template<class _Iter>
 		typename std::enable_if<_mse_Is_iterator<_Iter>::value, typename _MV::iterator>::type
-			insert(typename _MV::const_iterator _Where, _Iter _First, _Iter _Last) { return m_shptr->insert(_Where, _First, _Last); }
+			insert(typename _MV::const_iterator _Where, _Iter _First, _Iter _Last) { return shptr()->insert(_Where, _First, _Last); }
 		template<class
 #ifndef MSVC2010_COMPATIBILE
 			...
@@ -64,7 +71,7 @@ namespace mse {
 #ifndef MSVC2010_COMPATIBILE
 			...
 #endif /*MSVC2010_COMPATIBILE*/
-		_Val) { m_shptr->emplace_back(std::forward<_Valty>(_Val)
+		_Val) { shptr()->emplace_back(std::forward<_Valty>(_Val)
 #ifndef MSVC2010_COMPATIBILE
 			...
 #endif /*MSVC2010_COMPATIBILE*/
@@ -78,36 +85,36 @@ namespace mse {
 #ifndef MSVC2010_COMPATIBILE
 			...
 #endif /*MSVC2010_COMPATIBILE*/
-		_Val) { return m_shptr->emplace(_Where, std::forward<_Valty>(_Val)
+		_Val) { return shptr()->emplace(_Where, std::forward<_Valty>(_Val)
 #ifndef MSVC2010_COMPATIBILE
 			...
 #endif /*MSVC2010_COMPATIBILE*/
 		); }
-		typename _MV::iterator erase(typename _MV::iterator _P) { return m_shptr->emplace(_P); }
-		typename _MV::iterator erase(typename _MV::iterator _F, typename _MV::iterator _L) { return m_shptr->emplace(_F, _L); }
-		void clear() { m_shptr->clear(); }
-		void swap(_MV& _X) { m_shptr->swap(_X); }
-		void swap(_Myt& _X) { m_shptr->swap(_X.msevector()); }
+		typename _MV::iterator erase(typename _MV::iterator _P) { return shptr()->emplace(_P); }
+		typename _MV::iterator erase(typename _MV::iterator _F, typename _MV::iterator _L) { return shptr()->emplace(_F, _L); }
+		void clear() { shptr()->clear(); }
+		void swap(_MV& _X) { shptr()->swap(_X); }
+		void swap(_Myt& _X) { shptr()->swap(_X.msevector()); }
 
 #ifndef MSVC2010_COMPATIBILE
-		ivector(_XSTD initializer_list<typename _MV::value_type> _Ilist, const _A& _Al = _A()) : m_shptr(new _MV(_Ilist, _Al)) {}
-		_Myt& operator=(_XSTD initializer_list<typename _MV::value_type> _Ilist) { m_shptr->operator=(_Ilist); return (*this); }
-		void assign(_XSTD initializer_list<typename _MV::value_type> _Ilist) { m_shptr->assign(_Ilist); }
-		typename _MV::iterator insert(typename _MV::const_iterator _Where, _XSTD initializer_list<typename _MV::value_type> _Ilist) { return m_shptr->insert(_Where, _Ilist); }
+		ivector(_XSTD initializer_list<typename _MV::value_type> _Ilist, const _A& _Al = _A()) : m_shptr(_MV(_Ilist, _Al)) {}
+		_Myt& operator=(_XSTD initializer_list<typename _MV::value_type> _Ilist) { shptr()->operator=(_Ilist); return (*this); }
+		void assign(_XSTD initializer_list<typename _MV::value_type> _Ilist) { shptr()->assign(_Ilist); }
+		typename _MV::iterator insert(typename _MV::const_iterator _Where, _XSTD initializer_list<typename _MV::value_type> _Ilist) { return shptr()->insert(_Where, _Ilist); }
 #endif /*MSVC2010_COMPATIBILE*/
 
-		size_t capacity() const _NOEXCEPT{ return m_shptr->capacity(); }
-		void shrink_to_fit() { m_shptr->shrink_to_fit(); }
-		size_t size() const _NOEXCEPT{ return m_shptr->size(); }
-		size_t max_size() const _NOEXCEPT{ return m_shptr->max_size(); }
-		bool empty() const _NOEXCEPT{ return m_shptr->empty(); }
-		_A get_allocator() const _NOEXCEPT{ return m_shptr->get_allocator(); }
-		typename _MV::const_reference at(size_t _Pos) const { return m_shptr->at(_Pos); }
-		typename _MV::reference at(size_t _Pos) { return m_shptr->at(_Pos); }
-		typename _MV::reference front() { return m_shptr->front(); }
-		typename _MV::const_reference front() const { return m_shptr->front(); }
-		typename _MV::reference back() { return m_shptr->back(); }
-		typename _MV::const_reference back() const { return m_shptr->back(); }
+		size_t capacity() const _NOEXCEPT{ return const_msevector().capacity(); }
+		void shrink_to_fit() { shptr()->shrink_to_fit(); }
+		size_t size() const _NOEXCEPT{ return const_msevector().size(); }
+		size_t max_size() const _NOEXCEPT{ return const_msevector().max_size(); }
+		bool empty() const _NOEXCEPT{ return const_msevector().empty(); }
+		_A get_allocator() const _NOEXCEPT{ return const_msevector().get_allocator(); }
+		typename _MV::const_reference at(size_t _Pos) const { return const_msevector().at(_Pos); }
+		typename _MV::reference at(size_t _Pos) { return shptr()->at(_Pos); }
+		typename _MV::reference front() { return shptr()->front(); }
+		typename _MV::const_reference front() const { return const_msevector().front(); }
+		typename _MV::reference back() { return shptr()->back(); }
+		typename _MV::const_reference back() const { return const_msevector().back(); }
 
 		class cipointer {
 		public:
@@ -118,12 +125,13 @@ namespace mse {
 			typedef typename _MV::mm_const_iterator_type::pointer pointer;
 			typedef typename _MV::mm_const_iterator_type::reference reference;
 
-			cipointer(const _Myt& owner_cref) : m_msevector_shptr(owner_cref.m_shptr), m_cipointer_shptr(new typename _MV::cipointer(*(owner_cref.m_shptr))) {}
-			cipointer(const cipointer& src_cref) : m_msevector_shptr(src_cref.m_msevector_shptr), m_cipointer_shptr(new typename _MV::cipointer(*(src_cref.m_cipointer_shptr))) {
-				(*this) = src_cref;
-			}
+			cipointer(const _Myt& owner_cref) : m_msevector_shptr(owner_cref.shptr()), m_cipointer(*m_msevector_shptr) {}
+			cipointer(const cipointer& src_cref) : m_msevector_shptr(src_cref.m_msevector_shptr), m_cipointer(src_cref.m_cipointer) {}
+			/* A move takes over the source's registry slot. (The source keeps its reference to the msevector, so it remains
+			safe to use.) */
+			cipointer(cipointer&& src) MSE_MSEVECTOR_MOVE_NOEXCEPT : m_msevector_shptr(src.m_msevector_shptr), m_cipointer(std::move(src.m_cipointer)) {}
 			~cipointer() {}
-			typename _MV::cipointer& msevector_cipointer() const { return (*m_cipointer_shptr); }
+			typename _MV::cipointer& msevector_cipointer() const { return m_cipointer; }
 			typename _MV::cipointer& mvcip() const { return msevector_cipointer(); }
 
 			void reset() { msevector_cipointer().reset(); }
@@ -165,11 +173,13 @@ namespace mse {
 			void set_to_const_item_pointer(const cipointer& _Right_cref) { msevector_cipointer().set_to_const_item_pointer(_Right_cref.msevector_cipointer()); }
 			CSize_t position() const { return msevector_cipointer().position(); }
 		private:
-			cipointer(const std::shared_ptr<_MV>& msevector_shptr) : m_msevector_shptr(msevector_shptr), m_cipointer_shptr(new typename _MV::cipointer(*(msevector_shptr))) {}
-			std::shared_ptr<_MV> m_msevector_shptr;
-			/* m_cipointer_shptr needs to be declared after m_msevector_shptr so that it's destructor will be called first. */
-			std::shared_ptr<typename _MV::cipointer> m_cipointer_shptr;
-			friend class /*_Myt*/ivector<_Ty, _A>;
+			cipointer(const _MVPtr& msevector_shptr) : m_msevector_shptr(msevector_shptr), m_cipointer(*m_msevector_shptr) {}
+			_MVPtr m_msevector_shptr;
+			/* The msevector's cipointer (and so its registry slot) is held by value, so creating, copying and destroying a
+			cipointer doesn't allocate. (m_cipointer needs to be declared after m_msevector_shptr so that it's destructor will
+			be called first.) */
+			mutable typename _MV::cipointer m_cipointer;
+			friend class /*_Myt*/ivector<_Ty, _A, _TRefCount>;
 			friend class ipointer;
 		};
 		class ipointer {
@@ -181,12 +191,12 @@ namespace mse {
 			typedef typename _MV::mm_iterator_type::pointer pointer;
 			typedef typename _MV::mm_iterator_type::reference reference;
 
-			ipointer(_Myt& owner_ref) : m_msevector_shptr(owner_ref.m_shptr), m_ipointer_shptr(new typename _MV::ipointer(*(owner_ref.m_shptr))) {}
-			ipointer(const ipointer& src_cref) : m_msevector_shptr(src_cref.m_msevector_shptr), m_ipointer_shptr(new typename _MV::ipointer(*(src_cref.m_ipointer_shptr))) {
-				(*this) = src_cref;
-			}
+			ipointer(_Myt& owner_ref) : m_msevector_shptr(owner_ref.shptr()), m_ipointer(*m_msevector_shptr) {}
+			ipointer(const ipointer& src_cref) : m_msevector_shptr(src_cref.m_msevector_shptr), m_ipointer(src_cref.m_ipointer) {}
+			/* (As with cipointer, a move takes over the source's registry slot.) */
+			ipointer(ipointer&& src) MSE_MSEVECTOR_MOVE_NOEXCEPT : m_msevector_shptr(src.m_msevector_shptr), m_ipointer(std::move(src.m_ipointer)) {}
 			~ipointer() {}
-			typename _MV::ipointer& msevector_ipointer() const { return (*m_ipointer_shptr); }
+			typename _MV::ipointer& msevector_ipointer() const { return m_ipointer; }
 			typename _MV::ipointer& mvip() const { return msevector_ipointer(); }
 			//const mm_iterator_handle_type& handle() const { return (*m_handle_shptr); }
 			operator cipointer() const {
@@ -235,136 +245,187 @@ namespace mse {
 			void set_to_item_pointer(const ipointer& _Right_cref) { msevector_ipointer().set_to_item_pointer(_Right_cref.msevector_ipointer()); }
 			CSize_t position() const { return msevector_ipointer().position(); }
 		private:
-			std::shared_ptr<_MV> m_msevector_shptr;
-			/* m_ipointer_shptr needs to be declared after m_msevector_shptr so that it's destructor will be called first. */
-			std::shared_ptr<typename _MV::ipointer> m_ipointer_shptr;
-			friend class /*_Myt*/ivector<_Ty, _A>;
+			_MVPtr m_msevector_shptr;
+			/* (Held by value, as with cipointer. m_ipointer needs to be declared after m_msevector_shptr so that it's destructor
+			will be called first.) */
+			mutable typename _MV::ipointer m_ipointer;
+			friend class /*_Myt*/ivector<_Ty, _A, _TRefCount>;
 		};
 
 		/* begin() and end() are provided so that ivector can be used with stl algorithms. When using ipointers directly,
 		set_to_beginning() and set_to_end_marker() member functions are preferred. */
 		ipointer begin() {	// return ipointer for beginning of mutable sequence
 			ipointer retval(*this);
-			retval.m_ipointer_shptr->set_to_beginning();
+			retval.m_ipointer.set_to_beginning();
 			return retval;
 		}
 		cipointer begin() const {	// return ipointer for beginning of nonmutable sequence
 			cipointer retval(*this);
-			retval.m_cipointer_shptr->set_to_beginning();
+			retval.m_cipointer.set_to_beginning();
 			return retval;
 		}
 		ipointer end() {	// return ipointer for end of mutable sequence
 			ipointer retval(*this);
-			retval.m_ipointer_shptr->set_to_end_marker();
+			retval.m_ipointer.set_to_end_marker();
 			return retval;
 		}
 		cipointer end() const {	// return ipointer for end of nonmutable sequence
 			cipointer retval(*this);
-			retval.m_cipointer_shptr->set_to_end_marker();
+			retval.m_cipointer.set_to_end_marker();
 			return retval;
 		}
 		cipointer cbegin() const {	// return ipointer for beginning of nonmutable sequence
 			cipointer retval(*this);
-			retval.m_cipointer_shptr->set_to_beginning();
+			retval.m_cipointer.set_to_beginning();
 			return retval;
 		}
 		cipointer cend() const {	// return ipointer for end of nonmutable sequence
 			cipointer retval(*this);
-			retval.m_cipointer_shptr->set_to_beginning();
+			retval.m_cipointer.set_to_end_marker();
 			return retval;
 		}
 
 		ivector(const cipointer &start, const cipointer &end, const _A& _Al = _A())
-			: m_shptr(new _MV(start.msevector_cipointer(), end.msevector_cipointer(), _Al)) {}
+			: m_shptr(_MV(start.msevector_cipointer(), end.msevector_cipointer(), _Al)) {}
 		void assign(const cipointer &start, const cipointer &end) {
-			m_shptr->assign(start.msevector_cipointer(), end.msevector_cipointer());
+			shptr()->assign(start.msevector_cipointer(), end.msevector_cipointer());
 		}
 		void assign_inclusive(const cipointer &first, const cipointer &last) {
-			m_shptr->assign_inclusive(first.msevector_cipointer(), last.msevector_cipointer());
+			shptr()->assign_inclusive(first.msevector_cipointer(), last.msevector_cipointer());
 		}
+		/* The ipointer returned by these mutators points to the first inserted element. The overloads that take the position
+		by rvalue reference reuse its registry slot for the returned ipointer (rather than registering a new one). */
 		ipointer insert_before(const ipointer &pos, size_t _M, const _Ty& _X) {
-			auto res = m_shptr->insert_before(pos.msevector_ipointer(), _M, _X);
-			ipointer retval(*this); retval.msevector_ipointer() = res;
-			return retval;
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), _M, _X);
+			return ipointer_at(original_pos);
 		}
 		ipointer insert_before(const ipointer &pos, _Ty&& _X) {
-			auto res = m_shptr->insert_before(pos.msevector_ipointer(), std::move(_X));
-			ipointer retval(*this); retval.msevector_ipointer() = res;
-			return retval;
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), std::move(_X));
+			return ipointer_at(original_pos);
 		}
 		ipointer insert_before(const ipointer &pos, const _Ty& _X = _Ty()) { return insert_before(pos, 1, _X); }
 		ipointer insert_before(const ipointer &pos, const cipointer &start, const cipointer &end) {
-			auto res = m_shptr->insert_before(pos.msevector_ipointer(), start.msevector_cipointer(), end.msevector_cipointer());
-			ipointer retval(*this); retval.msevector_ipointer() = res;
-			return retval;
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), start.msevector_cipointer().const_item_pointer(), end.msevector_cipointer().const_item_pointer());
+			return ipointer_at(original_pos);
 		}
 		ipointer insert_before_inclusive(const ipointer &pos, const cipointer &first, const cipointer &last) {
 			auto end = last; end.set_to_next();
-			return insert_before_inclusive(pos, first, end);
+			return insert_before(pos, first, end);
 		}
 #ifndef MSVC2010_COMPATIBILE
 		ipointer insert_before(const ipointer &pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
-			auto res = m_shptr->insert_before(pos.msevector_ipointer(), _Ilist);
-			ipointer retval(*this); retval.msevector_ipointer() = res;
-			return retval;
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), _Ilist);
+			return ipointer_at(original_pos);
+		}
+#endif /*MSVC2010_COMPATIBILE*/
+		ipointer insert_before(ipointer&& pos, size_t _M, const _Ty& _X) {
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), _M, _X);
+			return moved_to(std::move(pos), original_pos);
+		}
+		ipointer insert_before(ipointer&& pos, _Ty&& _X) {
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), std::move(_X));
+			return moved_to(std::move(pos), original_pos);
+		}
+		ipointer insert_before(ipointer&& pos, const _Ty& _X = _Ty()) { return insert_before(std::move(pos), 1, _X); }
+#ifndef MSVC2010_COMPATIBILE
+		ipointer insert_before(ipointer&& pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
+			CSize_t original_pos = pos.position();
+			shptr()->insert_before(pos.msevector_ipointer().item_pointer(), _Ilist);
+			return moved_to(std::move(pos), original_pos);
 		}
 #endif /*MSVC2010_COMPATIBILE*/
 		void insert_before(CSize_t pos, _Ty&& _X) {
-			m_shptr->insert_before(pos, std::move(_X));
+			shptr()->insert_before(pos, std::move(_X));
 		}
 		void insert_before(CSize_t pos, const _Ty& _X = _Ty()) {
-			m_shptr->insert_before(pos, _X);
+			shptr()->insert_before(pos, _X);
 		}
 		void insert_before(CSize_t pos, size_t _M, const _Ty& _X) {
-			m_shptr->insert_before(pos, _M, _X);
+			shptr()->insert_before(pos, _M, _X);
 		}
 #ifndef MSVC2010_COMPATIBILE
 		void insert_before(CSize_t pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
-			m_shptr->insert_before(pos, _Ilist);
+			shptr()->insert_before(pos, _Ilist);
 		}
 #endif /*MSVC2010_COMPATIBILE*/
+		/* The ipointer returned by these erase() functions points to the element that followed the erased ones. */
 		ipointer erase(const ipointer &pos) {
-			auto res = m_shptr->erase(pos.msevector_ipointer());
-			ipointer retval(*this); retval.msevector_ipointer() = res;
-			return retval;
+			ipointer retval(pos);
+			return erase(std::move(retval));
+		}
+		ipointer erase(ipointer&& pos) {
+			CSize_t original_pos = pos.position();
+			shptr()->erase(pos.msevector_ipointer().item_pointer());
+			return moved_to(std::move(pos), original_pos);
 		}
 		ipointer erase(const ipointer &start, const ipointer &end) {
-			auto res = m_shptr->erase(start.msevector_ipointer(), end.msevector_ipointer());
-			ipointer retval(*this); retval.msevector_ipointer() = res;
-			return retval;
+			CSize_t original_pos = start.position();
+			shptr()->erase(start.msevector_ipointer().item_pointer(), end.msevector_ipointer().item_pointer());
+			return ipointer_at(original_pos);
 		}
 		ipointer erase_inclusive(const ipointer &first, const ipointer &last) {
 			auto end = last; end.set_to_next();
-			return erase_inclusive(first, end);
+			return erase(first, end);
 		}
 		bool operator==(const _Myt& _Right) const {	// test for ivector equality
-			return ((*(_Right.m_shptr)) == (*m_shptr));
+			return (_Right.const_msevector() == const_msevector());
 		}
 		bool operator<(const _Myt& _Right) const {	// test if _Left < _Right for ivectors
-			return ((*m_shptr) < (*(_Right.m_shptr)));
+			return (const_msevector() < _Right.const_msevector());
 			}
 
 	private:
-		std::shared_ptr<_MV> m_shptr;
+		ipointer ipointer_at(CSize_t position) {
+			ipointer retval(*this);
+			retval.advance(CInt(position));
+			return retval;
+		}
+		static ipointer moved_to(ipointer&& pos, CSize_t position) {
+			pos.set_to_beginning();
+			pos.advance(CInt(position));
+			return std::move(pos);
+		}
+		/* For an ivector that's been moved from, the mutators allocate a (new, empty) msevector. So do the const member
+		functions that return cipointers, as creating a cipointer registers it with the msevector (i.e. modifies it) anyway. */
+		const _MVPtr& shptr() const {
+			if (!m_shptr) { m_shptr = _MVPtr(_MV()); }
+			return m_shptr;
+		}
+		/* The other const member functions treat a moved-from ivector as empty, so they don't modify it (or allocate, or
+		throw where the msevector's const member functions don't). */
+		const _MV& const_msevector() const { return (!m_shptr) ? empty_msevector() : (*m_shptr); }
+		static const _MV& empty_msevector() {
+			static const _MV s_empty_msevector;
+			return s_empty_msevector;
+		}
+
+		/* Null only after the ivector has been moved from. */
+		mutable _MVPtr m_shptr;
 	};
 
-	template<class _Ty, class _Alloc> inline bool operator!=(const ivector<_Ty, _Alloc>& _Left,
-		const ivector<_Ty, _Alloc>& _Right) {	// test for ivector inequality
+	template<class _Ty, class _Alloc, class _TRefCount> inline bool operator!=(const ivector<_Ty, _Alloc, _TRefCount>& _Left,
+		const ivector<_Ty, _Alloc, _TRefCount>& _Right) {	// test for ivector inequality
 			return (!(_Left == _Right));
 		}
 
-	template<class _Ty, class _Alloc> inline bool operator>(const ivector<_Ty, _Alloc>& _Left,
-		const ivector<_Ty, _Alloc>& _Right) {	// test if _Left > _Right for ivectors
+	template<class _Ty, class _Alloc, class _TRefCount> inline bool operator>(const ivector<_Ty, _Alloc, _TRefCount>& _Left,
+		const ivector<_Ty, _Alloc, _TRefCount>& _Right) {	// test if _Left > _Right for ivectors
 			return (_Right < _Left);
 		}
 
-	template<class _Ty, class _Alloc> inline bool operator<=(const ivector<_Ty, _Alloc>& _Left,
-		const ivector<_Ty, _Alloc>& _Right) {	// test if _Left <= _Right for ivectors
+	template<class _Ty, class _Alloc, class _TRefCount> inline bool operator<=(const ivector<_Ty, _Alloc, _TRefCount>& _Left,
+		const ivector<_Ty, _Alloc, _TRefCount>& _Right) {	// test if _Left <= _Right for ivectors
 			return (!(_Right < _Left));
 		}
 
-	template<class _Ty, class _Alloc> inline bool operator>=(const ivector<_Ty, _Alloc>& _Left,
-		const ivector<_Ty, _Alloc>& _Right) {	// test if _Left >= _Right for ivectors
+	template<class _Ty, class _Alloc, class _TRefCount> inline bool operator>=(const ivector<_Ty, _Alloc, _TRefCount>& _Left,
+		const ivector<_Ty, _Alloc, _TRefCount>& _Right) {	// test if _Left >= _Right for ivectors
 			return (!(_Left < _Right));
 		}
 
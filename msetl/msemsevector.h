@@ -12,7 +12,22 @@
 #include <vector>
 #include <assert.h>
 #include <memory>
-#include <unordered_map>
+#include <new>
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <atomic>
+#ifdef __GLIBCXX__
+#include <ext/atomicity.h>
+#endif /*__GLIBCXX__*/
+#ifndef MSVC2010_COMPATIBILE
+#include <thread>
+#endif /*!MSVC2010_COMPATIBILE*/
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+#include <string>
+#include <sstream>
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
 
 namespace mse {
 
@@ -20,6 +35,29 @@ namespace mse {
 #define _NOEXCEPT
 #endif /*_NOEXCEPT*/
 
+/* Unlike _NOEXCEPT (which may be defined away), this one is honored wherever the compiler supports it, so that the
+containers' move operations are eligible for std::move_if_noexcept() (i.e. so they get moved, rather than copied, when
+the std::vector holding them reallocates). */
+#ifndef MSE_MSEVECTOR_MOVE_NOEXCEPT
+#ifdef MSVC2010_COMPATIBILE
+#define MSE_MSEVECTOR_MOVE_NOEXCEPT
+#else /*MSVC2010_COMPATIBILE*/
+#define MSE_MSEVECTOR_MOVE_NOEXCEPT noexcept
+#endif /*MSVC2010_COMPATIBILE*/
+#endif /*MSE_MSEVECTOR_MOVE_NOEXCEPT*/
+
+/* For keeping rarely taken (slow) paths out of line, so that the (fast) paths that call them remain small enough to be
+inlined. */
+#ifndef MSE_MSEVECTOR_NOINLINE
+#if defined(_MSC_VER)
+#define MSE_MSEVECTOR_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__)
+#define MSE_MSEVECTOR_NOINLINE __attribute__((noinline))
+#else /*defined(__GNUC__)*/
+#define MSE_MSEVECTOR_NOINLINE
+#endif /*defined(_MSC_VER)*/
+#endif /*MSE_MSEVECTOR_NOINLINE*/
+
 #ifndef _XSTD
 #define _XSTD ::std::
 #endif /*_XSTD*/
@@ -51,6 +89,165 @@ namespace mse {
 	  std::input_iterator_tag>::value>::type;
 #endif /*MSVC2010_COMPATIBILE*/
 
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+	/* When MSE_MSEVECTOR_INSTRUMENTATION is defined, each msevector counts the work done by its (ipointer) safety machinery,
+	and the counts are also aggregated over all msevectors. "iterators visited" counts the registered iterators (i.e.
+	ipointers) examined or updated by the fixup operations. Every reallocation results in one call to
+	sync_iterators_to_index(). */
+	class msevector_instrumentation_counts {
+	public:
+		msevector_instrumentation_counts() : m_shift_inclusive_range_calls(0), m_invalidate_inclusive_range_calls(0)
+			, m_sync_iterators_to_index_calls(0), m_iterators_visited(0), m_reallocations(0), m_live_ipointers(0)
+			, m_peak_live_ipointers(0), m_bounds_check_failures(0) {}
+		std::string as_json() const {
+			std::ostringstream sstream;
+			sstream << "{\"shift_inclusive_range_calls\": " << m_shift_inclusive_range_calls
+				<< ", \"invalidate_inclusive_range_calls\": " << m_invalidate_inclusive_range_calls
+				<< ", \"sync_iterators_to_index_calls\": " << m_sync_iterators_to_index_calls
+				<< ", \"iterators_visited\": " << m_iterators_visited
+				<< ", \"reallocations\": " << m_reallocations
+				<< ", \"live_ipointers\": " << m_live_ipointers
+				<< ", \"peak_live_ipointers\": " << m_peak_live_ipointers
+				<< ", \"bounds_check_failures\": " << m_bounds_check_failures << "}";
+			return sstream.str();
+		}
+
+		unsigned long long m_shift_inclusive_range_calls;
+		unsigned long long m_invalidate_inclusive_range_calls;
+		unsigned long long m_sync_iterators_to_index_calls;
+		unsigned long long m_iterators_visited;
+		unsigned long long m_reallocations;
+		unsigned long long m_live_ipointers;
+		unsigned long long m_peak_live_ipointers;
+		unsigned long long m_bounds_check_failures;
+	};
+
+	/* The aggregate counts are updated from any thread, so they're kept in atomics. */
+	class msevector_global_instrumentation {
+	public:
+		static msevector_instrumentation_counts counts() {
+			CAtomicCounts& atomic_counts_ref = atomic_counts();
+			msevector_instrumentation_counts retval;
+			retval.m_shift_inclusive_range_calls = atomic_counts_ref.m_shift_inclusive_range_calls.load();
+			retval.m_invalidate_inclusive_range_calls = atomic_counts_ref.m_invalidate_inclusive_range_calls.load();
+			retval.m_sync_iterators_to_index_calls = atomic_counts_ref.m_sync_iterators_to_index_calls.load();
+			retval.m_iterators_visited = atomic_counts_ref.m_iterators_visited.load();
+			retval.m_reallocations = atomic_counts_ref.m_reallocations.load();
+			retval.m_live_ipointers = atomic_counts_ref.m_live_ipointers.load();
+			retval.m_peak_live_ipointers = atomic_counts_ref.m_peak_live_ipointers.load();
+			retval.m_bounds_check_failures = atomic_counts_ref.m_bounds_check_failures.load();
+			return retval;
+		}
+		static std::string as_json() { return counts().as_json(); }
+		/* Zeros the counts (other than the number of live ipointers, which the peak is reset to). */
+		static void reset() {
+			CAtomicCounts& atomic_counts_ref = atomic_counts();
+			atomic_counts_ref.m_shift_inclusive_range_calls = 0;
+			atomic_counts_ref.m_invalidate_inclusive_range_calls = 0;
+			atomic_counts_ref.m_sync_iterators_to_index_calls = 0;
+			atomic_counts_ref.m_iterators_visited = 0;
+			atomic_counts_ref.m_reallocations = 0;
+			atomic_counts_ref.m_peak_live_ipointers = atomic_counts_ref.m_live_ipointers.load();
+			atomic_counts_ref.m_bounds_check_failures = 0;
+		}
+
+		static void note_shift_inclusive_range_call() { atomic_counts().m_shift_inclusive_range_calls += 1; }
+		static void note_invalidate_inclusive_range_call() { atomic_counts().m_invalidate_inclusive_range_calls += 1; }
+		static void note_reallocation() {
+			atomic_counts().m_sync_iterators_to_index_calls += 1;
+			atomic_counts().m_reallocations += 1;
+		}
+		static void note_iterators_visited(unsigned long long count) { atomic_counts().m_iterators_visited += count; }
+		static void note_ipointer_allocated() {
+			CAtomicCounts& atomic_counts_ref = atomic_counts();
+			unsigned long long live_ipointers = (atomic_counts_ref.m_live_ipointers += 1);
+			unsigned long long peak_live_ipointers = atomic_counts_ref.m_peak_live_ipointers.load();
+			while ((peak_live_ipointers < live_ipointers)
+				&& (!atomic_counts_ref.m_peak_live_ipointers.compare_exchange_weak(peak_live_ipointers, live_ipointers))) {}
+		}
+		static void note_ipointer_released() { atomic_counts().m_live_ipointers -= 1; }
+		static void note_bounds_check_failure() { atomic_counts().m_bounds_check_failures += 1; }
+
+	private:
+		class CAtomicCounts {
+		public:
+			CAtomicCounts() : m_shift_inclusive_range_calls(0), m_invalidate_inclusive_range_calls(0)
+				, m_sync_iterators_to_index_calls(0), m_iterators_visited(0), m_reallocations(0), m_live_ipointers(0)
+				, m_peak_live_ipointers(0), m_bounds_check_failures(0) {}
+			std::atomic<unsigned long long> m_shift_inclusive_range_calls;
+			std::atomic<unsigned long long> m_invalidate_inclusive_range_calls;
+			std::atomic<unsigned long long> m_sync_iterators_to_index_calls;
+			std::atomic<unsigned long long> m_iterators_visited;
+			std::atomic<unsigned long long> m_reallocations;
+			std::atomic<unsigned long long> m_live_ipointers;
+			std::atomic<unsigned long long> m_peak_live_ipointers;
+			std::atomic<unsigned long long> m_bounds_check_failures;
+		};
+		static CAtomicCounts& atomic_counts() {
+			static CAtomicCounts s_atomic_counts;
+			return s_atomic_counts;
+		}
+	};
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+
+#ifndef MSVC2010_COMPATIBILE
+	/* An allocator adaptor that default initializes (rather than value initializes) elements constructed without arguments.
+	Used with msevector (i.e. msevector<_Ty, msevector_default_init_allocator<_Ty> >), resize_default_init() and
+	append_uninitialized() don't zero fill trivial element types. */
+	template<class _Ty, class _A = std::allocator<_Ty> >
+	class msevector_default_init_allocator : public _A {
+	public:
+		typedef std::allocator_traits<_A> base_traits;
+		template<class _Uty>
+		struct rebind {
+			typedef msevector_default_init_allocator<_Uty, typename base_traits::template rebind_alloc<_Uty> > other;
+		};
+		msevector_default_init_allocator() {}
+		msevector_default_init_allocator(const _A& _Al) : _A(_Al) {}
+		template<class _Uty>
+		msevector_default_init_allocator(const msevector_default_init_allocator<_Uty, typename base_traits::template rebind_alloc<_Uty> >& _Al) : _A(_Al) {}
+		template<class _Uty>
+		void construct(_Uty* ptr) { ::new (static_cast<void*>(ptr)) _Uty; }
+		template<class _Uty, class... _Args>
+		void construct(_Uty* ptr, _Args&&... args) { base_traits::construct(static_cast<_A&>(*this), ptr, std::forward<_Args>(args)...); }
+	};
+#endif /*!MSVC2010_COMPATIBILE*/
+
+	/* When inserting and erasing, msevector moves the elements of "trivially relocatable" types around in its buffer with
+	memmove() rather than element by element. Trivially destructible types whose objects can be safely moved by just copying
+	their bytes (like plain records with user-provided copy operations) can opt in by specializing this template to derive
+	from std::true_type. (Trivially copyable types don't need to, as std::vector already moves those with memmove().) (Erasures
+	overwrite the erased elements without destroying them, so opting in a type that isn't trivially destructible is a
+	compile error.) */
+	template<class _Ty>
+	struct msevector_is_trivially_relocatable : public std::false_type {};
+
+	template<class _Ty>
+	struct _mse_msevector_is_trivially_destructible : public std::integral_constant<bool,
+#if defined(MSVC2010_COMPATIBILE) || (defined(__GNUC__) && (!defined(__clang__)) && (5 > __GNUC__))
+		/* (std::is_trivially_destructible<> isn't (reliably) available) */
+		__has_trivial_destructor(_Ty)> {};
+#else /*defined(MSVC2010_COMPATIBILE) || (defined(__GNUC__) && (!defined(__clang__)) && (5 > __GNUC__))*/
+		std::is_trivially_destructible<_Ty>::value> {};
+#endif /*defined(MSVC2010_COMPATIBILE) || (defined(__GNUC__) && (!defined(__clang__)) && (5 > __GNUC__))*/
+
+	template<class _Ty>
+	struct _mse_msevector_relocates_bitwise : public std::integral_constant<bool, (!std::is_same<_Ty, bool>::value)
+		&& msevector_is_trivially_relocatable<_Ty>::value> {
+		static_assert((!msevector_is_trivially_relocatable<_Ty>::value) || _mse_msevector_is_trivially_destructible<_Ty>::value
+			, "types opted in with msevector_is_trivially_relocatable<> must be trivially destructible - msevector");
+	};
+
+	/* Savepoints journal copies of the elements that are removed, so they're only supported for copyable element types. */
+	template<class _Ty>
+	struct _mse_msevector_journals_removals : public std::integral_constant<bool,
+#ifdef MSVC2010_COMPATIBILE
+		/* (std::is_copy_constructible<> isn't available) */
+		true> {};
+#else /*MSVC2010_COMPATIBILE*/
+		std::is_copy_constructible<_Ty>::value> {};
+#endif /*MSVC2010_COMPATIBILE*/
+
 	/* Note that, at the moment, msevector inherits publicly from std::vector. This is not intended to be a permanent
 		characteristic of msevector and any reference to, or interpretation of, an msevector as an std::vector is (and has
 		always been) depricated. msevector endeavors to support the subset of the std::vector interface that is compatible
@@ -65,50 +262,64 @@ namespace mse {
 		typedef msevector<_Ty, _A> _Myt;
 
 		explicit msevector(const _A& _Al = _A())
-			: base_class(_Al), m_mmitset(*this) {
-			m_debug_size = size();
+			: base_class(_Al) {
+			update_debug_size();
 		}
 		explicit msevector(size_t _N, const _Ty& _V = _Ty(), const _A& _Al = _A())
-			: base_class(_N, _V, _Al), m_mmitset(*this) {
-			m_debug_size = size();
+			: base_class(_N, _V, _Al) {
+			update_debug_size();
+		}
+		msevector(base_class&& _X) : base_class(std::move(_X)) { update_debug_size(); }
+		msevector(const base_class& _X) : base_class(_X) { update_debug_size(); }
+		/* Moves transfer just the elements (without allocating). Ipointers and savepoints stay with the vector they were
+		obtained from. So the moved-from vector's ipointers become end markers (of the now empty vector), and its savepoints
+		are discarded (i.e. rolling back to, or releasing, them throws). Resetting the ipointers visits each of them, so
+		unlike the transfer of the elements, that part isn't constant time. */
+		msevector(_Myt&& _X) MSE_MSEVECTOR_MOVE_NOEXCEPT : base_class(std::move(static_cast<base_class&>(_X))) {
+			update_debug_size();
+			_X.detach_ipointers_and_savepoints();
 		}
-		msevector(base_class&& _X) : base_class(std::move(_X)), m_mmitset(*this) { m_debug_size = size(); }
-		msevector(const base_class& _X) : base_class(_X), m_mmitset(*this) { m_debug_size = size(); }
-		msevector(_Myt&& _X) : base_class(std::move(_X)), m_mmitset(*this) { m_debug_size = size(); }
-		msevector(const _Myt& _X) : base_class(_X), m_mmitset(*this) { m_debug_size = size(); }
+		msevector(const _Myt& _X) : base_class(_X) { update_debug_size(); }
 		typedef typename base_class::const_iterator _It;
 		/* Note that safety cannot be guaranteed when using these constructors that take unsafe typename base_class::iterator and/or pointer parameters. */
-		msevector(_It _F, _It _L, const _A& _Al = _A()) : base_class(_F, _L, _Al), m_mmitset(*this) { m_debug_size = size(); }
-		msevector(const _Ty*  _F, const _Ty*  _L, const _A& _Al = _A()) : base_class(_F, _L, _Al), m_mmitset(*this) { m_debug_size = size(); }
+		msevector(_It _F, _It _L, const _A& _Al = _A()) : base_class(_F, _L, _Al) { update_debug_size(); }
+		msevector(const _Ty*  _F, const _Ty*  _L, const _A& _Al = _A()) : base_class(_F, _L, _Al) { update_debug_size(); }
 		template<class _Iter
 #ifndef MSVC2010_COMPATIBILE
 			//, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type
 			, class = _mse_RequireInputIter<_Iter>
 #endif /*MSVC2010_COMPATIBILE*/
 		>
-		msevector(_Iter _First, _Iter _Last) : base_class(_First, _Last), m_mmitset(*this) { m_debug_size = size(); }
+		msevector(_Iter _First, _Iter _Last) : base_class(_First, _Last) { update_debug_size(); }
 		template<class _Iter
 #ifndef MSVC2010_COMPATIBILE
 			//, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type
 			, class = _mse_RequireInputIter<_Iter>
 #endif /*MSVC2010_COMPATIBILE*/
 		>
-		//msevector(_Iter _First, _Iter _Last, const typename base_class::_Alloc& _Al) : base_class(_First, _Last, _Al), m_mmitset(*this) { m_debug_size = size(); }
-		msevector(_Iter _First, _Iter _Last, const _A& _Al) : base_class(_First, _Last, _Al), m_mmitset(*this) { m_debug_size = size(); }
+		//msevector(_Iter _First, _Iter _Last, const typename base_class::_Alloc& _Al) : base_class(_First, _Last, _Al) { update_debug_size(); }
+		msevector(_Iter _First, _Iter _Last, const _A& _Al) : base_class(_First, _Last, _Al) { update_debug_size(); }
 		_Myt& operator=(const base_class& _X) {
+			journal_erasure(0, (*this).size());
 			base_class::operator =(_X);
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			journal_insertion(0, (*this).size());
+			m_aux_state.reset();
 			return (*this);
 		}
-		_Myt& operator=(_Myt&& _X) {
-			operator=(std::move(static_cast<base_class&>(_X)));
-			m_mmitset.reset();
+		/* The target's ipointers become end markers (as with copy assignment), but since the target's previous elements
+		aren't retained, its savepoints are discarded along with the moved-from vector's. */
+		_Myt& operator=(_Myt&& _X) MSE_MSEVECTOR_MOVE_NOEXCEPT {
+			if (std::addressof(_X) == this) { return (*this); }
+			base_class::operator=(std::move(static_cast<base_class&>(_X)));
+			update_debug_size();
+			detach_ipointers_and_savepoints();
+			_X.detach_ipointers_and_savepoints();
 			return (*this);
 		}
 		_Myt& operator=(const _Myt& _X) {
 			operator=((base_class)_X);
-			m_mmitset.reset();
+			m_aux_state.reset();
 			return (*this);
 		}
 		void reserve(size_t _Count)
@@ -120,7 +331,7 @@ namespace mse {
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 		}
 		void shrink_to_fit() {	// reduce capacity
@@ -131,7 +342,7 @@ namespace mse {
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 		}
 		void resize(size_t _N, const _Ty& _X = _Ty()) {
@@ -139,39 +350,91 @@ namespace mse {
 			auto original_capacity = CSize_t((*this).capacity());
 			bool shrinking = (_N < original_size);
 
+			if (shrinking) {
+				journal_erasure(_N, original_size - _N);
+			}
 			base_class::resize(_N, _X);
-			m_debug_size = size();
+			update_debug_size();
+			if (!shrinking) {
+				journal_insertion(original_size, _N - original_size);
+			}
 
 			if (shrinking) {
-				m_mmitset.invalidate_inclusive_range(_N, CSize_t(original_size - 1));
+				m_aux_state.invalidate_inclusive_range(_N, CSize_t(original_size - 1));
 			}
-			m_mmitset.shift_inclusive_range(original_size, original_size, CSize_t(_N) - original_size); /*shift the end markers*/
+			m_aux_state.shift_inclusive_range(original_size, original_size, CSize_t(_N) - original_size); /*shift the end markers*/
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
+			}
+		}
+		/* Like resize(), but any new elements are constructed without arguments (by the allocator) rather than copied from a
+		value. With msevector_default_init_allocator, trivial element types are then left uninitialized (default
+		initialized) instead of being zero filled, which is useful when the new elements are about to be overwritten anyway.
+		(With std::allocator they are value initialized.) */
+		void resize_default_init(size_t _N) {
+			if ((*this).size() >= _N) {
+				if ((*this).size() > _N) { erase(base_class::begin() + _N, base_class::end()); }
+				return;
+			}
+			append_default_init(_N - (*this).size());
+		}
+		/* A bounds checked view of a contiguous range of the vector's elements. Each access is checked against both the span's
+		size and the vector's current size (so a span that outlives a shrinking of the vector throws rather than accessing
+		elements that no longer exist). data() is provided for interfacing with legacy functions (like read()) and, of
+		course, isn't checked. */
+		class checked_span {
+		public:
+			size_t size() const { return m_size; }
+			bool empty() const { return (0 == m_size); }
+			/* The position (in the vector) of the first element of the span. */
+			size_t position() const { return m_position; }
+			typename base_class::reference operator[](size_t index) const {
+				if ((m_size <= index) || (m_owner_ptr->size() <= m_position + index)) { m_owner_ptr->note_bounds_check_failure(); throw(std::out_of_range("index out of range - reference operator[]() - msevector::checked_span")); }
+				return m_owner_ptr->base_class::operator[](m_position + index);
+			}
+			typename base_class::reference at(size_t index) const { return (*this)[index]; }
+			_Ty* data() const {
+				if (m_owner_ptr->size() < m_position + m_size) { m_owner_ptr->note_bounds_check_failure(); throw(std::out_of_range("span no longer valid - _Ty* data() - msevector::checked_span")); }
+				return (m_owner_ptr->base_class::data() + m_position);
 			}
+		private:
+			checked_span(_Myt& owner_ref, size_t position, size_t size) : m_owner_ptr(&owner_ref), m_position(position), m_size(size) {}
+			_Myt* m_owner_ptr;
+			size_t m_position;
+			size_t m_size;
+			friend class /*_Myt*/msevector<_Ty, _A>;
+		};
+		/* Appends count elements in the manner of resize_default_init() and returns a (bounds checked) span of them to be
+		written to. */
+		checked_span append_uninitialized(size_t count) {
+			const size_t original_size = (*this).size();
+			append_default_init(count);
+			return checked_span(*this, original_size, count);
 		}
 		typename base_class::const_reference operator[](size_t _P) const {
+			if (size() <= _P) { note_bounds_check_failure(); }
 			return at(_P);
 		}
 		typename base_class::reference operator[](size_t _P) {
+			if (size() <= _P) { note_bounds_check_failure(); }
 			return at(_P);
 		}
 		typename base_class::reference front() {	// return first element of mutable sequence
-			if (0 == size()) { throw(std::out_of_range("front() on empty - typename base_class::reference front() - msevector")); }
+			if (0 == size()) { note_bounds_check_failure(); throw(std::out_of_range("front() on empty - typename base_class::reference front() - msevector")); }
 			return base_class::front();
 		}
 		typename base_class::const_reference front() const {	// return first element of nonmutable sequence
-			if (0 == size()) { throw(std::out_of_range("front() on empty - typename base_class::const_reference front() - msevector")); }
+			if (0 == size()) { note_bounds_check_failure(); throw(std::out_of_range("front() on empty - typename base_class::const_reference front() - msevector")); }
 			return base_class::front();
 		}
 		typename base_class::reference back() {	// return last element of mutable sequence
-			if (0 == size()) { throw(std::out_of_range("back() on empty - typename base_class::reference back() - msevector")); }
+			if (0 == size()) { note_bounds_check_failure(); throw(std::out_of_range("back() on empty - typename base_class::reference back() - msevector")); }
 			return base_class::back();
 		}
 		typename base_class::const_reference back() const {	// return last element of nonmutable sequence
-			if (0 == size()) { throw(std::out_of_range("back() on empty - typename base_class::const_reference back() - msevector")); }
+			if (0 == size()) { note_bounds_check_failure(); throw(std::out_of_range("back() on empty - typename base_class::const_reference back() - msevector")); }
 			return base_class::back();
 		}
 		void push_back(_Ty&& _X) {
@@ -179,14 +442,15 @@ namespace mse {
 			auto original_capacity = CSize_t((*this).capacity());
 
 			base_class::push_back(std::move(_X));
-			m_debug_size = size();
+			update_debug_size();
 
 			assert((original_size + 1) == CSize_t((*this).size()));
-			m_mmitset.shift_inclusive_range(original_size, original_size, 1); /*shift the end markers*/
+			journal_insertion(original_size, 1);
+			m_aux_state.shift_inclusive_range(original_size, original_size, 1); /*shift the end markers*/
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 		}
 		void push_back(const _Ty& _X) {
@@ -194,48 +458,56 @@ namespace mse {
 			auto original_capacity = CSize_t((*this).capacity());
 
 			base_class::push_back(_X);
-			m_debug_size = size();
+			update_debug_size();
 
 			assert((original_size + 1) == CSize_t((*this).size()));
-			m_mmitset.shift_inclusive_range(original_size, original_size, 1); /*shift the end markers*/
+			journal_insertion(original_size, 1);
+			m_aux_state.shift_inclusive_range(original_size, original_size, 1); /*shift the end markers*/
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 		}
 		void pop_back() {
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
-			if (0 == original_size) { throw(std::out_of_range("pop_back() on empty - void pop_back() - msevector")); }
+			if (0 == original_size) { note_bounds_check_failure(); throw(std::out_of_range("pop_back() on empty - void pop_back() - msevector")); }
+			journal_erasure(original_size - 1, 1);
 			base_class::pop_back();
-			m_debug_size = size();
+			update_debug_size();
 
 			assert((original_size - 1) == CSize_t((*this).size()));
-			m_mmitset.invalidate_inclusive_range(CSize_t(original_size - 1), CSize_t(original_size - 1));
-			m_mmitset.shift_inclusive_range(original_size, original_size, -1); /*shift the end markers*/
+			m_aux_state.invalidate_inclusive_range(CSize_t(original_size - 1), CSize_t(original_size - 1));
+			m_aux_state.shift_inclusive_range(original_size, original_size, -1); /*shift the end markers*/
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 		}
 		void assign(_It _F, _It _L) {
+			journal_erasure(0, (*this).size());
 			base_class::assign(_F, _L);
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			journal_insertion(0, (*this).size());
+			m_aux_state.reset();
 		}
 		template<class _Iter>
 		void assign(_Iter _First, _Iter _Last) {	// assign [_First, _Last)
+			journal_erasure(0, (*this).size());
 			base_class::assign(_First, _Last);
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			journal_insertion(0, (*this).size());
+			m_aux_state.reset();
 		}
 		void assign(size_t _N, const _Ty& _X = _Ty()) {
+			journal_erasure(0, (*this).size());
 			base_class::assign(_N, _X);
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			journal_insertion(0, (*this).size());
+			m_aux_state.reset();
 		}
 		typename base_class::iterator insert(typename base_class::iterator _P, _Ty&& _X) {
 			return (emplace(_P, std::move(_X)));
@@ -243,21 +515,23 @@ namespace mse {
 		typename base_class::iterator insert(typename base_class::iterator _P, const _Ty& _X = _Ty()) {
 			CInt di = std::distance(base_class::begin(), _P);
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
-			typename base_class::iterator retval = base_class::insert(_P, _X);
-			m_debug_size = size();
+			base_insert_n(mse::as_a_size_t(d), 1, _X, _mse_msevector_relocates_bitwise<_Ty>());
+			typename base_class::iterator retval = base_class::begin() + mse::as_a_size_t(d);
+			update_debug_size();
 
 			assert((original_size + 1) == CSize_t((*this).size()));
 			assert(d == std::distance(base_class::begin(), retval));
-			m_mmitset.shift_inclusive_range(d, original_size, 1);
+			journal_insertion(d, 1);
+			m_aux_state.shift_inclusive_range(d, original_size, 1);
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 			return retval;
 		}
@@ -271,26 +545,27 @@ namespace mse {
 			insert(typename base_class::const_iterator _P, size_t _M, const _Ty& _X) {
 				CInt di = std::distance(base_class::cbegin(), _P);
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
+			base_insert_n(mse::as_a_size_t(d), _M, _X, _mse_msevector_relocates_bitwise<_Ty>());
 #ifndef MSVC2010_COMPATIBILE
-			typename base_class::iterator retval =
+			typename base_class::iterator retval = base_class::begin() + mse::as_a_size_t(d);
 #endif /*MSVC2010_COMPATIBILE*/
-				base_class::insert(_P, _M, _X);
-			m_debug_size = size();
+			update_debug_size();
 
 			assert((original_size + _M) == CSize_t((*this).size()));
 #ifndef MSVC2010_COMPATIBILE
 			assert(d == std::distance(base_class::begin(), retval));
 #endif /*MSVC2010_COMPATIBILE*/
-			m_mmitset.shift_inclusive_range(d, original_size, _M);
+			journal_insertion(d, _M);
+			m_aux_state.shift_inclusive_range(d, original_size, _M);
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 #ifndef MSVC2010_COMPATIBILE
 			return retval;
@@ -306,28 +581,28 @@ namespace mse {
 			insert(typename base_class::const_iterator _Where, _Iter _First, _Iter _Last) {	// insert [_First, _Last) at _Where
 				CInt di = std::distance(base_class::cbegin(), _Where);
 				CSize_t d(di);
-				if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+				if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
-				auto _M = CInt(std::distance(_First, _Last));
 				auto original_size = CSize_t((*this).size());
 				auto original_capacity = CSize_t((*this).capacity());
 
 				//if (0 > _M) { throw(std::out_of_range("invalid argument - typename base_class::iterator insert() - msevector")); }
+				base_insert_range(mse::as_a_size_t(d), _First, _Last, _mse_msevector_relocates_bitwise<_Ty>());
 #ifndef MSVC2010_COMPATIBILE
-				auto retval = 
+				auto retval = base_class::begin() + mse::as_a_size_t(d);
 #endif /*MSVC2010_COMPATIBILE*/
-					base_class::insert(_Where, _First, _Last);
-				m_debug_size = size();
-
-				assert((original_size + _M) == CSize_t((*this).size()));
+				update_debug_size();
+				/* (The number of elements inserted is obtained afterwards so that input iterators are only traversed once.) */
+				auto _M = CInt(CSize_t((*this).size()) - original_size);
 #ifndef MSVC2010_COMPATIBILE
 				assert(d == std::distance(base_class::begin(), retval));
 #endif /*MSVC2010_COMPATIBILE*/
-				m_mmitset.shift_inclusive_range(d, original_size, _M);
+				journal_insertion(d, _M);
+				m_aux_state.shift_inclusive_range(d, original_size, _M);
 				auto new_capacity = CSize_t((*this).capacity());
 				bool realloc_occured = (new_capacity != original_capacity);
 				if (realloc_occured) {
-					m_mmitset.sync_iterators_to_index();
+					m_aux_state.sync_iterators_to_index();
 				}
 #ifndef MSVC2010_COMPATIBILE
 				return retval;
@@ -342,22 +617,22 @@ namespace mse {
 			insert(typename base_class::/*const_*/iterator _P, size_t _M, const _Ty& _X) {
 				CInt di = std::distance(base_class::/*c*/begin(), _P);
 				CSize_t d(di);
-				if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+				if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
 				auto original_size = CSize_t((*this).size());
 				auto original_capacity = CSize_t((*this).capacity());
 
-				/*typename base_class::iterator retval =*/
-					base_class::insert(_P, _M, _X);
-				m_debug_size = size();
+				base_insert_n(mse::as_a_size_t(d), _M, _X, _mse_msevector_relocates_bitwise<_Ty>());
+				update_debug_size();
 
 				assert((original_size + _M) == CSize_t((*this).size()));
 				/*assert(d == std::distance(base_class::begin(), retval));*/
-				m_mmitset.shift_inclusive_range(d, original_size, _M);
+				journal_insertion(d, _M);
+				m_aux_state.shift_inclusive_range(d, original_size, _M);
 				auto new_capacity = CSize_t((*this).capacity());
 				bool realloc_occured = (new_capacity != original_capacity);
 				if (realloc_occured) {
-					m_mmitset.sync_iterators_to_index();
+					m_aux_state.sync_iterators_to_index();
 				}
 				/*return retval;*/
 			}
@@ -367,24 +642,23 @@ namespace mse {
 		insert(typename base_class::/*const_*/iterator _Where, _Iter _First, _Iter _Last) {	// insert [_First, _Last) at _Where
 				CInt di = std::distance(base_class::/*c*/begin(), _Where);
 				CSize_t d(di);
-				if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+				if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
-				auto _M = CInt(std::distance(_First, _Last));
 				auto original_size = CSize_t((*this).size());
 				auto original_capacity = CSize_t((*this).capacity());
 
 				//if (0 > _M) { throw(std::out_of_range("invalid argument - typename base_class::iterator insert() - msevector")); }
-				/*auto retval =*/
-					base_class::insert(_Where, _First, _Last);
-				m_debug_size = size();
-
-				assert((original_size + _M) == CSize_t((*this).size()));
+				base_insert_range(mse::as_a_size_t(d), _First, _Last, _mse_msevector_relocates_bitwise<_Ty>());
+				update_debug_size();
+				/* (The number of elements inserted is obtained afterwards so that input iterators are only traversed once.) */
+				auto _M = CInt(CSize_t((*this).size()) - original_size);
 				/*assert(d == std::distance(base_class::begin(), retval));*/
-				m_mmitset.shift_inclusive_range(d, original_size, _M);
+				journal_insertion(d, _M);
+				m_aux_state.shift_inclusive_range(d, original_size, _M);
 				auto new_capacity = CSize_t((*this).capacity());
 				bool realloc_occured = (new_capacity != original_capacity);
 				if (realloc_occured) {
-					m_mmitset.sync_iterators_to_index();
+					m_aux_state.sync_iterators_to_index();
 				}
 				/*return retval;*/
 			}
@@ -409,15 +683,61 @@ namespace mse {
 				...
 #endif /*MSVC2010_COMPATIBILE*/
 				);
-			m_debug_size = size();
+			update_debug_size();
 
 			assert((original_size + 1) == CSize_t((*this).size()));
-			m_mmitset.shift_inclusive_range(original_size, original_size, 1); /*shift the end markers*/
+			journal_insertion(original_size, 1);
+			m_aux_state.shift_inclusive_range(original_size, original_size, 1); /*shift the end markers*/
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
+			}
+		}
+		/* Appends the elements of [first, last). For forward iterators the required capacity is reserved up front. For input
+		iterators the (optional) size hint is used instead. Unlike a sequence of push_back()s, the (registered) ipointers
+		are fixed up just once, at the end. */
+		template<class _TIter
+#ifndef MSVC2010_COMPATIBILE
+			, class = _mse_RequireInputIter<_TIter> >
+#else /*MSVC2010_COMPATIBILE*/
+			>
+#endif /*MSVC2010_COMPATIBILE*/
+		void append_range(_TIter first, _TIter last, size_t size_hint = 0) {
+			const size_t original_size = (*this).size();
+			const size_t original_capacity = (*this).capacity();
+			try {
+				reserve_for_append(first, last, size_hint, typename std::iterator_traits<_TIter>::iterator_category());
+				for (; last != first; ++first) {
+					base_class::emplace_back(*first);
+				}
+			}
+			catch (...) {
+				complete_append(original_size, original_capacity);
+				throw;
+			}
+			complete_append(original_size, original_capacity);
+		}
+		template<class _TRange>
+		void append_range(const _TRange& range, size_t size_hint = 0) {
+			append_range(std::begin(range), std::end(range), size_hint);
+		}
+		/* Appends count elements, each constructed from the value returned by a call to the generator. */
+		template<class _TGenerator>
+		void append_generated(size_t count, _TGenerator generator) {
+			const size_t original_size = (*this).size();
+			const size_t original_capacity = (*this).capacity();
+			try {
+				reserve_for_growth(count);
+				for (size_t i = 0; count > i; i += 1) {
+					base_class::emplace_back(generator());
+				}
+			}
+			catch (...) {
+				complete_append(original_size, original_capacity);
+				throw;
 			}
+			complete_append(original_size, original_capacity);
 		}
 		template<class
 #ifndef MSVC2010_COMPATIBILE
@@ -438,136 +758,236 @@ namespace mse {
 			CInt di = std::distance(base_class::/*c*/begin(), _Where);
 #endif /*!(defined(GPP4P8_COMPATIBILE))*/
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator emplace() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator emplace() - msevector")); }
 
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
-			auto retval = base_class::emplace(_Where, std::forward<_Valty>(_Val)
+			base_emplace(mse::as_a_size_t(d), _mse_msevector_relocates_bitwise<_Ty>(), std::forward<_Valty>(_Val)
 #ifndef MSVC2010_COMPATIBILE
 				...
 #endif /*MSVC2010_COMPATIBILE*/
 				);
-			m_debug_size = size();
+			auto retval = base_class::begin() + mse::as_a_size_t(d);
+			update_debug_size();
 
 			assert((original_size + 1) == CSize_t((*this).size()));
 			assert(d == std::distance(base_class::begin(), retval));
-			m_mmitset.shift_inclusive_range(d, original_size, 1);
+			journal_insertion(d, 1);
+			m_aux_state.shift_inclusive_range(d, original_size, 1);
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 			return retval;
 		}
 		typename base_class::iterator erase(typename base_class::iterator _P) {
 			CInt di = std::distance(base_class::begin(), _P);
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator erase() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator erase() - msevector")); }
 
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
 			if (end() == _P) { throw(std::out_of_range("invalid argument - typename base_class::iterator erase(typename base_class::iterator _P) - msevector")); }
-			typename base_class::iterator retval = base_class::erase(_P);
-			m_debug_size = size();
+			journal_erasure(d, 1);
+			base_erase(mse::as_a_size_t(d), mse::as_a_size_t(d) + 1, _mse_msevector_relocates_bitwise<_Ty>());
+			typename base_class::iterator retval = base_class::begin() + mse::as_a_size_t(d);
+			update_debug_size();
 
 			assert((original_size - 1) == CSize_t((*this).size()));
 			assert(d == std::distance(base_class::begin(), retval));
 			{
-				m_mmitset.invalidate_inclusive_range(d, d);
-				m_mmitset.shift_inclusive_range(CSize_t(d + 1), original_size, -1);
+				m_aux_state.invalidate_inclusive_range(d, d);
+				m_aux_state.shift_inclusive_range(CSize_t(d + 1), original_size, -1);
 			}
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 			return retval;
 		}
 		typename base_class::iterator erase(typename base_class::iterator _F, typename base_class::iterator _L) {
 			CInt di = std::distance(base_class::begin(), _F);
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator erase() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator erase() - msevector")); }
 			CInt di2 = std::distance(base_class::begin(), _L);
 			CSize_t d2(di2);
-			if ((0 > di2) || (CSize_t((*this).size()) < di2)) { throw(std::out_of_range("index out of range - typename base_class::iterator erase() - msevector")); }
+			if ((0 > di2) || (CSize_t((*this).size()) < di2)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator erase() - msevector")); }
 
 			auto _M = CInt(std::distance(_F, _L));
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
 			if ((end() == _F)/* || (0 > _M)*/) { throw(std::out_of_range("invalid argument - typename base_class::iterator erase(typename base_class::iterator _F, typename base_class::iterator _L) - msevector")); }
-			typename base_class::iterator retval = base_class::erase(_F, _L);
-			m_debug_size = size();
+			journal_erasure(d, _M);
+			base_erase(mse::as_a_size_t(d), mse::as_a_size_t(d2), _mse_msevector_relocates_bitwise<_Ty>());
+			typename base_class::iterator retval = base_class::begin() + mse::as_a_size_t(d);
+			update_debug_size();
 
 			assert((original_size - _M) == CSize_t((*this).size()));
 			assert(d == std::distance(base_class::begin(), retval));
 			{
 				if (1 <= _M) {
-					m_mmitset.invalidate_inclusive_range(d, CSize_t(d + _M - 1));
+					m_aux_state.invalidate_inclusive_range(d, CSize_t(d + _M - 1));
 				}
-				m_mmitset.shift_inclusive_range(CSize_t(d + _M), original_size, -_M);
+				m_aux_state.shift_inclusive_range(CSize_t(d + _M), original_size, -_M);
 			}
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 			return retval;
 		}
+		/* Removes the elements that satisfy the predicate in a single (compacting) pass, and then fixes up the (registered)
+		ipointers in a single merged pass. ipointers to surviving elements follow their elements, and ipointers to removed
+		elements become end markers. If the predicate throws, the remaining elements are kept and the vector (and its ipointers)
+		are left in a consistent state. Returns the number of elements removed. */
+		template<class _TPredicate>
+		size_t erase_if(_TPredicate pred) {
+			return erase_if_in_range(0, (*this).size(), pred);
+		}
+		/* The following functions reorder the elements such that (registered) ipointers follow their elements. When there are
+		registered ipointers, the elements are reordered (once) along with their original positions, and the ipointers are
+		then remapped in a single pass. Otherwise the elements are just reordered directly. While any savepoint is outstanding,
+		the permutation is journaled (so the elements are reordered along with their original positions even if there are no
+		registered ipointers). If a comparison or element move throws, the vector is left valid but its order is unspecified,
+		its ipointers are reset and its savepoints are discarded (i.e. rolling back to, or releasing, them throws). */
+		void sort() { sort(std::less<_Ty>()); }
+		template<class _TCompare>
+		void sort(_TCompare comp) {
+			m_aux_state.note_structural_change();
+			if (!tracks_reorderings()) { std::sort(base_class::begin(), base_class::end(), comp); return; }
+			reorder_tracking_positions(sc_reorder_sort, 0, comp);
+		}
+		void stable_sort() { stable_sort(std::less<_Ty>()); }
+		template<class _TCompare>
+		void stable_sort(_TCompare comp) {
+			m_aux_state.note_structural_change();
+			if (!tracks_reorderings()) { std::stable_sort(base_class::begin(), base_class::end(), comp); return; }
+			reorder_tracking_positions(sc_reorder_stable_sort, 0, comp);
+		}
+		void nth_element(size_t nth) { nth_element(nth, std::less<_Ty>()); }
+		template<class _TCompare>
+		void nth_element(size_t nth, _TCompare comp) {
+			if ((*this).size() <= nth) { throw(std::out_of_range("invalid argument - void nth_element() - msevector")); }
+			m_aux_state.note_structural_change();
+			if (!tracks_reorderings()) { std::nth_element(base_class::begin(), base_class::begin() + nth, base_class::end(), comp); return; }
+			reorder_tracking_positions(sc_reorder_nth_element, nth, comp);
+		}
+		/* old_positions[i] is the (current) position of the element to be moved to position i. It must be a permutation of
+		[0, size()). The elements are moved into place one cycle at a time. */
+		void apply_permutation(const std::vector<size_t>& old_positions) {
+			if (old_positions.size() != (*this).size()) { throw(std::out_of_range("invalid argument - void apply_permutation() - msevector")); }
+			{
+				std::vector<bool> seen(old_positions.size(), false);
+				for (size_t i = 0; old_positions.size() > i; i += 1) {
+					if ((old_positions.size() <= old_positions[i]) || (seen[old_positions[i]])) { throw(std::out_of_range("invalid argument - void apply_permutation() - msevector")); }
+					seen[old_positions[i]] = true;
+				}
+			}
+			permute_elements(old_positions);
+		}
+		/* Moves the elements at positions [first, last) of src to before position dest_pos. The (registered) ipointers and
+		cipointers to the moved elements are moved (to this vector's registry) along with them rather than being invalidated.
+		The other ipointers of both vectors are adjusted as they would be by the corresponding insert() and erase(). If src is
+		this vector, the elements are rotated into place (and dest_pos must not be strictly inside [first, last)). The move is
+		journaled by the savepoints of each vector as an insertion and an erasure respectively (and a rotation within one vector
+		is journaled as a rotation). While src has outstanding savepoints, the elements are copied rather than moved, as src's
+		journal needs to retain the (intact) elements it removes. */
+		void splice(CSize_t dest_pos, _Myt& src, CSize_t first, CSize_t last) {
+			const size_t dest_position = mse::as_a_size_t(dest_pos);
+			const size_t first_position = mse::as_a_size_t(first);
+			const size_t last_position = mse::as_a_size_t(last);
+			if ((first_position > last_position) || (src.size() < last_position) || ((*this).size() < dest_position)) {
+				throw(std::out_of_range("invalid argument - void splice() - msevector"));
+			}
+			if (&src == this) {
+				rotate_range_to(dest_position, first_position, last_position);
+				return;
+			}
+			if (first_position == last_position) { return; }
+
+			std::vector<std::pair<cipointer*, size_t> > moving_cipointers;
+			std::vector<std::pair<ipointer*, size_t> > moving_ipointers;
+			if (src.has_registered_ipointers()) {
+				src.m_aux_state.mmitset().collect_handle_owners_in_range(first_position, last_position - 1, moving_cipointers, moving_ipointers);
+			}
+			splice_insert(dest_position, src, first_position, last_position, _mse_msevector_journals_removals<_Ty>());
+			src.erase(src.base_class::begin() + first_position, src.base_class::begin() + last_position);
+			/* The (now invalidated) ipointers in src are reregistered with this vector, pointing to their elements' new positions. */
+			for (size_t i = 0; moving_cipointers.size() > i; i += 1) {
+				adopt_cipointer(*(moving_cipointers[i].first), dest_position + (moving_cipointers[i].second - first_position));
+			}
+			for (size_t i = 0; moving_ipointers.size() > i; i += 1) {
+				adopt_ipointer(*(moving_ipointers[i].first), dest_position + (moving_ipointers[i].second - first_position));
+			}
+		}
 		void clear() {
+			journal_erasure(0, (*this).size());
 			base_class::clear();
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			m_aux_state.reset();
 		}
 		void swap(base_class& _X) {
+			journal_erasure(0, (*this).size());
 			base_class::swap(_X);
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			journal_insertion(0, (*this).size());
+			m_aux_state.reset();
 		}
 		void swap(_Myt& _X) {
+			_X.journal_erasure(0, _X.size());
 			swap(static_cast<base_class&>(_X));
-			m_mmitset.reset();
+			_X.update_debug_size();
+			_X.journal_insertion(0, _X.size());
+			_X.m_aux_state.note_structural_change();
+			m_aux_state.reset();
 		}
 
 #ifndef MSVC2010_COMPATIBILE
 		msevector(_XSTD initializer_list<typename base_class::value_type> _Ilist,
 			const _A& _Al = _A())
-			: base_class(_Ilist, _Al), m_mmitset(*this) {	// construct from initializer_list
-			m_debug_size = size();
+			: base_class(_Ilist, _Al) {	// construct from initializer_list
+			update_debug_size();
 		}
 		_Myt& operator=(_XSTD initializer_list<typename base_class::value_type> _Ilist) {	// assign initializer_list
 			operator=((base_class)_Ilist);
-			m_mmitset.reset();
+			m_aux_state.reset();
 			return (*this);
 		}
 		void assign(_XSTD initializer_list<typename base_class::value_type> _Ilist) {	// assign initializer_list
+			journal_erasure(0, (*this).size());
 			base_class::assign(_Ilist);
-			m_debug_size = size();
-			m_mmitset.reset();
+			update_debug_size();
+			journal_insertion(0, (*this).size());
+			m_aux_state.reset();
 		}
 #if defined(GPP4P8_COMPATIBILE)
 		/* g++4.8 seems to be (incorrectly) using the c++98 version of this insert function instead of the c++11 version. */
 		/*typename base_class::iterator*/void insert(typename base_class::/*const_*/iterator _Where, _XSTD initializer_list<typename base_class::value_type> _Ilist) {	// insert initializer_list
 			CInt di = std::distance(base_class::/*c*/begin(), _Where);
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
 			auto _M = _Ilist.size();
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
-			/*auto retval = */base_class::insert(_Where, _Ilist);
-			m_debug_size = size();
+			base_insert_range(mse::as_a_size_t(d), _Ilist.begin(), _Ilist.end(), _mse_msevector_relocates_bitwise<_Ty>());
+			update_debug_size();
 
 			assert((original_size + _M) == CSize_t((*this).size()));
 			/*assert(d == std::distance(base_class::begin(), retval));*/
-			m_mmitset.shift_inclusive_range(d, original_size, _M);
+			journal_insertion(d, _M);
+			m_aux_state.shift_inclusive_range(d, original_size, _M);
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 			/*return retval;*/
 		}
@@ -575,29 +995,83 @@ namespace mse {
 		typename base_class::iterator insert(typename base_class::const_iterator _Where, _XSTD initializer_list<typename base_class::value_type> _Ilist) {	// insert initializer_list
 			CInt di = std::distance(base_class::cbegin(), _Where);
 			CSize_t d(di);
-			if ((0 > di) || (CSize_t((*this).size()) < di)) { throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
+			if ((0 > di) || (CSize_t((*this).size()) < di)) { note_bounds_check_failure(); throw(std::out_of_range("index out of range - typename base_class::iterator insert() - msevector")); }
 
 			auto _M = _Ilist.size();
 			auto original_size = CSize_t((*this).size());
 			auto original_capacity = CSize_t((*this).capacity());
 
-			auto retval = base_class::insert(_Where, _Ilist);
-			m_debug_size = size();
+			base_insert_range(mse::as_a_size_t(d), _Ilist.begin(), _Ilist.end(), _mse_msevector_relocates_bitwise<_Ty>());
+			auto retval = base_class::begin() + mse::as_a_size_t(d);
+			update_debug_size();
 
 			assert((original_size + _M) == CSize_t((*this).size()));
 			assert(d == std::distance(base_class::begin(), retval));
-			m_mmitset.shift_inclusive_range(d, original_size, _M);
+			journal_insertion(d, _M);
+			m_aux_state.shift_inclusive_range(d, original_size, _M);
 			auto new_capacity = CSize_t((*this).capacity());
 			bool realloc_occured = (new_capacity != original_capacity);
 			if (realloc_occured) {
-				m_mmitset.sync_iterators_to_index();
+				m_aux_state.sync_iterators_to_index();
 			}
 			return retval;
 		}
 #endif /*defined(GPP4P8_COMPATIBILE)*/
 #endif /*MSVC2010_COMPATIBILE*/
 
+#ifdef MSE_MSEVECTOR_DEBUG_SIZE
+		/* A copy of the size that's easy to inspect in a debugger. It's opt-in because it adds to the size of every vector. */
 		size_t m_debug_size;
+		void update_debug_size() { m_debug_size = size(); }
+#else /*MSE_MSEVECTOR_DEBUG_SIZE*/
+		void update_debug_size() {}
+#endif /*MSE_MSEVECTOR_DEBUG_SIZE*/
+
+	private:
+		static const size_t sc_unregistered_slot_index = size_t(-1);
+		/* The state that ss iterators resync to when the vector's buffer generation changes. (It's obtained from the vector,
+		rather than written to the iterator by reference, so that the iterator's address doesn't escape, which would keep
+		the compiler from holding the iterator in registers in loops.) */
+		struct CBufferGenerationSnapshot {
+			const size_t* m_buffer_generation_ptr;
+			size_t m_buffer_generation;
+			size_t m_size;
+			typename base_class::iterator m_position_iterator;
+		};
+		CBufferGenerationSnapshot buffer_generation_snapshot(size_t position, const char* error_message) const {
+			const size_t* buffer_generation_ptr = m_aux_state.buffer_generation_ptr();
+			if ((!buffer_generation_ptr) || ((*this).size() < position)) {
+				return allocating_buffer_generation_snapshot(position, error_message);
+			}
+			CBufferGenerationSnapshot retval;
+			retval.m_buffer_generation_ptr = buffer_generation_ptr;
+			retval.m_buffer_generation = (*buffer_generation_ptr);
+			retval.m_size = (*this).size();
+			retval.m_position_iterator = const_cast<_Myt&>(*this).base_class::begin() + position;
+			return retval;
+		}
+		/* (The first snapshot allocates the auxiliary state.) */
+		MSE_MSEVECTOR_NOINLINE CBufferGenerationSnapshot allocating_buffer_generation_snapshot(size_t position, const char* error_message) const {
+			if ((*this).size() < position) { note_bounds_check_failure(); throw(std::out_of_range(error_message)); }
+			m_aux_state.allocated();
+			return buffer_generation_snapshot(position, error_message);
+		}
+		/* Default constructed ss iterators point to this (which never matches their own generation), so they don't need a
+		null check. */
+		static const size_t& unattached_buffer_generation() {
+			static const size_t s_unattached_buffer_generation = 0;
+			return s_unattached_buffer_generation;
+		}
+		/* Called on both vectors involved in a move. It doesn't allocate (the registry keeps enough capacity in its end marker
+		index to hold every ipointer). */
+		void detach_ipointers_and_savepoints() {
+			update_debug_size();
+			m_aux_state.discard_journal();
+			m_aux_state.reset();
+		}
+	public:
+		class cipointer;
+		class ipointer;
 
 		/* Note that, at the moment, mm_const_iterator_type inherits publicly from typename base_class::const_iterator. This is not intended to be a permanent
 		characteristc of mm_const_iterator_type and any reference to, or interpretation of, an mm_const_iterator_type as an typename base_class::const_iterator is (and has
@@ -641,11 +1115,13 @@ namespace mse {
 					m_points_to_an_item = true;
 				}
 				else { assert(false == m_points_to_an_item); }
+				note_position_change();
 			}
 			void set_to_end_marker() {
 				m_index = m_owner_cref.size();
 				base_class::const_iterator::operator=(m_owner_cref.cend());
 				m_points_to_an_item = false;
+				note_position_change();
 			}
 			void set_to_next() {
 				if (points_to_an_item()) {
@@ -655,8 +1131,10 @@ namespace mse {
 						(*this).m_points_to_an_item = false;
 						if (m_owner_cref.size() < m_index) { assert(false); reset(); }
 					}
+					note_position_change();
 				}
 				else {
+					m_owner_cref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - void set_to_next() - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -665,8 +1143,10 @@ namespace mse {
 					m_index -= 1;
 					base_class::const_iterator::operator--();
 					(*this).m_points_to_an_item = true;
+					note_position_change();
 				}
 				else {
+					m_owner_cref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - void set_to_previous() - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -677,6 +1157,7 @@ namespace mse {
 			void advance(difference_type n) {
 				auto new_index = CInt(m_index) + n;
 				if ((0 > new_index) || (m_owner_cref.size() < new_index)) {
+					m_owner_cref.note_bounds_check_failure();
 					throw(std::out_of_range("index out of range - void advance(difference_type n) - mm_const_iterator_type - msevector"));
 				}
 				else {
@@ -688,6 +1169,7 @@ namespace mse {
 					else {
 						(*this).m_points_to_an_item = true;
 					}
+					note_position_change();
 				}
 			}
 			void regress(difference_type n) { advance(-n); }
@@ -711,6 +1193,7 @@ namespace mse {
 					return m_owner_cref.at(mse::as_a_size_t(m_index));
 				}
 				else {
+					m_owner_cref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - const_reference operator*() const - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -720,6 +1203,7 @@ namespace mse {
 					return m_owner_cref.at(m_index - 1);
 				}
 				else {
+					m_owner_cref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - const_reference previous_item() const - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -730,6 +1214,7 @@ namespace mse {
 					return base_class::const_iterator::operator->();
 				}
 				else {
+					m_owner_cref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - pointer operator->() const - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -761,6 +1246,7 @@ namespace mse {
 					(*this).m_points_to_an_item = _Right_cref.m_points_to_an_item;
 					(*this).m_index = _Right_cref.m_index;
 					base_class::const_iterator::operator=(_Right_cref);
+					note_position_change();
 				}
 				else {
 					throw(std::out_of_range("doesn't seem to be a valid assignment value - mm_const_iterator_type& operator=(const typename base_class::iterator& _Right_cref) - mm_const_iterator_type - msevector"));
@@ -787,7 +1273,11 @@ namespace mse {
 			void shift_inclusive_range(mse::CSize_t index_of_first, mse::CSize_t index_of_last, mse::CInt shift) {
 				if ((index_of_first <= (*this).m_index) && (index_of_last >= (*this).m_index)) {
 					auto new_index = (*this).m_index + shift;
-					if ((0 > new_index) || (m_owner_cref.size() < new_index)) {
+					if (!((*this).m_points_to_an_item)) {
+						/* End markers (including ones that were just invalidated) simply track the end of the vector. */
+						(*this).set_to_end_marker();
+					}
+					else if ((0 > new_index) || (m_owner_cref.size() < new_index)) {
 						throw(std::out_of_range("void shift_inclusive_range() - mm_const_iterator_type - msevector"));
 					}
 					else {
@@ -800,8 +1290,12 @@ namespace mse {
 				return m_index;
 			}
 		private:
-			mm_const_iterator_type(const _Myt& owner_cref) : m_owner_cref(owner_cref) { set_to_beginning(); }
-			mm_const_iterator_type(const mm_const_iterator_type& src_cref) : m_owner_cref(src_cref.m_owner_cref) { (*this) = src_cref; }
+			mm_const_iterator_type(const _Myt& owner_cref) : m_owner_cref(owner_cref), m_registry_slot_index(sc_unregistered_slot_index), m_handle_owner_ptr(nullptr) { set_to_beginning(); }
+			mm_const_iterator_type(const mm_const_iterator_type& src_cref) : m_owner_cref(src_cref.m_owner_cref), m_registry_slot_index(sc_unregistered_slot_index), m_handle_owner_ptr(nullptr) { (*this) = src_cref; }
+			/* Lets the registry know (if this iterator is registered) that it needs to re-sort this iterator by position. */
+			void note_position_change() {
+				if (sc_unregistered_slot_index != m_registry_slot_index) { m_owner_cref.m_aux_state.mmitset().note_position_change(*this); }
+			}
 			void sync_const_iterator_to_index() {
 				assert(m_owner_cref.size() >= (*this).m_index);
 				base_class::const_iterator::operator=(m_owner_cref.cbegin());
@@ -810,6 +1304,10 @@ namespace mse {
 			mse::CBool m_points_to_an_item;
 			mse::CSize_t m_index;
 			const _Myt& m_owner_cref;
+			/* The index of the registry slot holding this iterator, if it is registered (i.e. belongs to a cipointer). */
+			size_t m_registry_slot_index;
+			/* The cipointer this iterator belongs to, if it is registered. (Used to move the cipointer to another vector.) */
+			cipointer* m_handle_owner_ptr;
 			friend class mm_iterator_set_type;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 			friend class mm_iterator_type;
@@ -854,11 +1352,13 @@ namespace mse {
 					m_points_to_an_item = true;
 				}
 				else { assert(false == m_points_to_an_item); }
+				note_position_change();
 			}
 			void set_to_end_marker() {
 				m_index = m_owner_ref.size();
 				base_class::iterator::operator=(m_owner_ref.end());
 				m_points_to_an_item = false;
+				note_position_change();
 			}
 			void set_to_next() {
 				if (points_to_an_item()) {
@@ -868,8 +1368,10 @@ namespace mse {
 						(*this).m_points_to_an_item = false;
 						if (m_owner_ref.size() < m_index) { assert(false); reset(); }
 					}
+					note_position_change();
 				}
 				else {
+					m_owner_ref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - void set_to_next() - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -878,8 +1380,10 @@ namespace mse {
 					m_index -= 1;
 					base_class::iterator::operator--();
 					(*this).m_points_to_an_item = true;
+					note_position_change();
 				}
 				else {
+					m_owner_ref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - void set_to_previous() - mm_iterator_type - msevector"));
 				}
 			}
@@ -890,6 +1394,7 @@ namespace mse {
 			void advance(difference_type n) {
 				auto new_index = CInt(m_index) + n;
 				if ((0 > new_index) || (m_owner_ref.size() < new_index)) {
+					m_owner_ref.note_bounds_check_failure();
 					throw(std::out_of_range("index out of range - void advance(difference_type n) - mm_iterator_type - msevector"));
 				}
 				else {
@@ -901,6 +1406,7 @@ namespace mse {
 					else {
 						(*this).m_points_to_an_item = true;
 					}
+					note_position_change();
 				}
 			}
 			void regress(int n) { advance(-n); }
@@ -924,6 +1430,7 @@ namespace mse {
 					return m_owner_ref.at(mse::as_a_size_t(m_index));
 				}
 				else {
+					m_owner_ref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - reference operator*() - mm_iterator_type - msevector"));
 				}
 			}
@@ -933,6 +1440,7 @@ namespace mse {
 					return m_owner_ref.at(m_index - 1);
 				}
 				else {
+					m_owner_ref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - reference previous_item() - mm_const_iterator_type - msevector"));
 				}
 			}
@@ -942,6 +1450,7 @@ namespace mse {
 					return base_class::iterator::operator->();
 				}
 				else {
+					m_owner_ref.note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - pointer operator->() - mm_iterator_type - msevector"));
 				}
 			}
@@ -973,6 +1482,7 @@ namespace mse {
 					(*this).m_points_to_an_item = _Right_cref.m_points_to_an_item;
 					(*this).m_index = _Right_cref.m_index;
 					base_class::iterator::operator=(_Right_cref);
+					note_position_change();
 				}
 				else {
 					throw(std::out_of_range("doesn't seem to be a valid assignment value - mm_iterator_type& operator=(const typename base_class::iterator& _Right_cref) - mm_const_iterator_type - msevector"));
@@ -999,7 +1509,11 @@ namespace mse {
 			void shift_inclusive_range(mse::CSize_t index_of_first, mse::CSize_t index_of_last, mse::CInt shift) {
 				if ((index_of_first <= (*this).m_index) && (index_of_last >= (*this).m_index)) {
 					auto new_index = (*this).m_index + shift;
-					if ((0 > new_index) || (m_owner_ref.size() < new_index)) {
+					if (!((*this).m_points_to_an_item)) {
+						/* End markers (including ones that were just invalidated) simply track the end of the vector. */
+						(*this).set_to_end_marker();
+					}
+					else if ((0 > new_index) || (m_owner_ref.size() < new_index)) {
 						throw(std::out_of_range("void shift_inclusive_range() - mm_iterator_type - msevector"));
 					}
 					else {
@@ -1018,8 +1532,12 @@ namespace mse {
 				return retval;
 			}
 		private:
-			mm_iterator_type(_Myt& owner_ref) : m_owner_ref(owner_ref) { set_to_beginning(); }
-			mm_iterator_type(const mm_iterator_type& src_cref) : m_owner_ref(src_cref.m_owner_ref) { (*this) = src_cref; }
+			mm_iterator_type(_Myt& owner_ref) : m_owner_ref(owner_ref), m_registry_slot_index(sc_unregistered_slot_index), m_handle_owner_ptr(nullptr) { set_to_beginning(); }
+			mm_iterator_type(const mm_iterator_type& src_cref) : m_owner_ref(src_cref.m_owner_ref), m_registry_slot_index(sc_unregistered_slot_index), m_handle_owner_ptr(nullptr) { (*this) = src_cref; }
+			/* Lets the registry know (if this iterator is registered) that it needs to re-sort this iterator by position. */
+			void note_position_change() {
+				if (sc_unregistered_slot_index != m_registry_slot_index) { m_owner_ref.m_aux_state.mmitset().note_position_change(*this); }
+			}
 			void sync_iterator_to_index() {
 				assert(m_owner_ref.size() >= (*this).m_index);
 				base_class::iterator::operator=(m_owner_ref.begin());
@@ -1028,6 +1546,10 @@ namespace mse {
 			mse::CBool m_points_to_an_item;
 			mse::CSize_t m_index;
 			_Myt& m_owner_ref;
+			/* The index of the registry slot holding this iterator, if it is registered (i.e. belongs to an ipointer). */
+			size_t m_registry_slot_index;
+			/* The ipointer this iterator belongs to, if it is registered. (Used to move the ipointer to another vector.) */
+			ipointer* m_handle_owner_ptr;
 			friend class mm_iterator_set_type;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
@@ -1036,74 +1558,527 @@ namespace mse {
 		typedef std::size_t CHashKey1;
 		class mm_const_iterator_handle_type {
 		public:
-			mm_const_iterator_handle_type(const CHashKey1& key_cref, std::shared_ptr<mm_const_iterator_type>& shptr_cref) : m_shptr(shptr_cref), m_key(key_cref) {}
+			mm_const_iterator_handle_type(const CHashKey1& key_cref) : m_key(key_cref) {}
 		private:
-			std::shared_ptr<mm_const_iterator_type> m_shptr;
 			CHashKey1 m_key;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 			friend class mm_iterator_set_type;
 		};
 		class mm_iterator_handle_type {
 		public:
-			mm_iterator_handle_type(const CHashKey1& key_cref, std::shared_ptr<mm_iterator_type>& shptr_ref) : m_shptr(shptr_ref), m_key(key_cref) {}
+			mm_iterator_handle_type(const CHashKey1& key_cref) : m_key(key_cref) {}
 		private:
-			std::shared_ptr<mm_iterator_type> m_shptr;
 			CHashKey1 m_key;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 			friend class mm_iterator_set_type;
 		};
 
-		class mm_iterator_set_type {
+		/* TMMIteratorSlab stores registered mm iterators in fixed size chunks of contiguous slots. Released slots are kept on an
+		intrusive free list and reused, so in the steady state registering and releasing an ipointer doesn't touch the heap. A
+		slot's index (which serves as the handle key) and its address remain stable for as long as the slot is in use.
+		The slab also maintains a "position index" of the slots holding iterators that point to an item, sorted by position, and
+		a separate list of the slots holding end markers. The index is stored as two parallel arrays (positions and slot
+		indexes) so that shifting a range of positions is a simple loop over contiguous integers that the compiler can
+		vectorize. The slab doesn't itself know the positions of its items. Slots whose items are allocated, released or moved
+		are just flagged as "unindexed" and settle_position_index() (re)inserts them in a single merge pass the next time the
+		index is needed. */
+		template<class _TItem>
+		class TMMIteratorSlab {
 		public:
-			class CMMConstIterators : public std::unordered_map<CHashKey1, std::shared_ptr<mm_const_iterator_type>> {};
-			class CMMIterators : public std::unordered_map<CHashKey1, std::shared_ptr<mm_iterator_type>> {};
+			typedef std::vector<CHashKey1> CSlotIndexList;
 
-			mm_iterator_set_type(_Myt& owner_ref) : m_owner_ref(owner_ref), m_next_available_key(0) {}
-			void reset() {
-				for (auto it = m_aux_mm_const_iterator_shptrs.begin(); m_aux_mm_const_iterator_shptrs.end() != it; it++) {
-					(*it).second->reset();
+			TMMIteratorSlab() : m_first_free_slot(sc_no_slot), m_number_of_slots_used(0), m_number_of_items(0)
+				, m_positions_need_compaction(false), m_end_markers_need_compaction(false) {}
+			~TMMIteratorSlab() { release_all(); }
+
+			template<class _TOwner>
+			CHashKey1 allocate(_TOwner& owner_ref) {
+				/* The end marker index is kept with enough capacity to hold every item, so that reindex_all_as_end_markers() (which
+				is used by the (noexcept) moves) doesn't allocate. */
+				if (m_end_marker_slot_indices.capacity() <= m_number_of_items) {
+					m_end_marker_slot_indices.reserve(2 * (m_number_of_items + 1));
+				}
+				CHashKey1 slot_index = sc_no_slot;
+				if (sc_no_slot != m_first_free_slot) {
+					slot_index = m_first_free_slot;
+					m_first_free_slot = slot(slot_index).m_next_free_slot;
+				}
+				else {
+					if (m_chunks.size() * sc_chunk_size <= m_number_of_slots_used) {
+						m_chunks.push_back(std::unique_ptr<CChunk>(new CChunk()));
+					}
+					slot_index = m_number_of_slots_used;
+					m_number_of_slots_used += 1;
+				}
+				CSlot& slot_ref = slot(slot_index);
+				try {
+					::new (static_cast<void*>(&(slot_ref.m_storage))) _TItem(owner_ref);
+				}
+				catch (...) {
+					slot_ref.m_next_free_slot = m_first_free_slot;
+					m_first_free_slot = slot_index;
+					throw;
+				}
+				slot_ref.m_in_use = true;
+				m_number_of_items += 1;
+				mark_unindexed(slot_index);
+				return slot_index;
+			}
+			void release(CHashKey1 slot_index) {
+				CSlot& slot_ref = slot(slot_index);
+				assert(slot_ref.m_in_use);
+				item_from_slot(slot_ref).~_TItem();
+				slot_ref.m_in_use = false;
+				slot_ref.m_next_free_slot = m_first_free_slot;
+				m_first_free_slot = slot_index;
+				m_number_of_items -= 1;
+				mark_unindexed(slot_index);
+			}
+			void release_all() {
+				for (CHashKey1 slot_index = 0; m_number_of_slots_used > slot_index; slot_index += 1) {
+					CSlot& slot_ref = slot(slot_index);
+					if (slot_ref.m_in_use) {
+						item_from_slot(slot_ref).~_TItem();
+						slot_ref.m_in_use = false;
+					}
+					slot_ref.m_unindexed = false;
+					slot_ref.m_indexed_as = sc_not_indexed;
 				}
-				for (auto it = m_aux_mm_iterator_shptrs.begin(); m_aux_mm_iterator_shptrs.end() != it; it++) {
-					(*it).second->reset();
+				/* The chunks are retained for reuse. */
+				m_first_free_slot = sc_no_slot;
+				m_number_of_slots_used = 0;
+				m_number_of_items = 0;
+				m_positions.clear();
+				m_position_slot_indices.clear();
+				m_end_marker_slot_indices.clear();
+				m_unindexed_slot_indices.clear();
+				m_positions_need_compaction = false;
+				m_end_markers_need_compaction = false;
+			}
+			bool is_in_use(CHashKey1 slot_index) const {
+				return ((m_number_of_slots_used > slot_index) && (slot(slot_index).m_in_use));
+			}
+			_TItem& item(CHashKey1 slot_index) const {
+				assert(is_in_use(slot_index));
+				return item_from_slot(slot(slot_index));
+			}
+			size_t size() const { return m_number_of_items; }
+			bool empty() const { return (0 == m_number_of_items); }
+			/* Calls func_ref(item) for each item in use. The slots are visited in index order, chunk by chunk. */
+			template<class _TFunction>
+			void for_each(_TFunction& func_ref) const {
+				if (0 == m_number_of_items) { return; }
+				CHashKey1 slot_index = 0;
+				for (size_t chunk_index = 0; m_chunks.size() > chunk_index; chunk_index += 1) {
+					CSlot* slots = m_chunks[chunk_index]->m_slots;
+					for (size_t i = 0; (sc_chunk_size > i) && (m_number_of_slots_used > slot_index); i += 1, slot_index += 1) {
+						if (slots[i].m_in_use) {
+							func_ref(item_from_slot(slots[i]));
+						}
+					}
 				}
 			}
-			void sync_iterators_to_index() {
-				for (auto it = m_aux_mm_const_iterator_shptrs.begin(); m_aux_mm_const_iterator_shptrs.end() != it; it++) {
-					(*it).second->sync_const_iterator_to_index();
+
+			/* Flags the slot as needing to be (re)inserted into the position index. */
+			void mark_unindexed(CHashKey1 slot_index) {
+				CSlot& slot_ref = slot(slot_index);
+				if (!slot_ref.m_unindexed) {
+					slot_ref.m_unindexed = true;
+					m_unindexed_slot_indices.push_back(slot_index);
+					/* Only slots that already have an entry require the index to be compacted. */
+					if (sc_indexed_by_position == slot_ref.m_indexed_as) {
+						m_positions_need_compaction = true;
+					}
+					else if (sc_indexed_as_end_marker == slot_ref.m_indexed_as) {
+						m_end_markers_need_compaction = true;
+					}
+				}
+			}
+			/* Brings the position index up to date. position_of_ref(item, position) must return false if the item is an end
+			marker, otherwise it must set position to the item's position and return true. */
+			template<class _TPositionOfFunction>
+			void settle_position_index(_TPositionOfFunction& position_of_ref) {
+				if (m_unindexed_slot_indices.empty()) { return; }
+
+				/* First we remove any stale entries belonging to unindexed slots. */
+				if (m_positions_need_compaction) {
+					size_t number_of_entries_kept = 0;
+					for (size_t i = 0; m_positions.size() > i; i += 1) {
+						if (!(slot(m_position_slot_indices[i]).m_unindexed)) {
+							m_positions[number_of_entries_kept] = m_positions[i];
+							m_position_slot_indices[number_of_entries_kept] = m_position_slot_indices[i];
+							number_of_entries_kept += 1;
+						}
+					}
+					m_positions.resize(number_of_entries_kept);
+					m_position_slot_indices.resize(number_of_entries_kept);
+					m_positions_need_compaction = false;
+				}
+				if (m_end_markers_need_compaction) {
+					size_t number_of_entries_kept = 0;
+					for (size_t i = 0; m_end_marker_slot_indices.size() > i; i += 1) {
+						if (!(slot(m_end_marker_slot_indices[i]).m_unindexed)) {
+							m_end_marker_slot_indices[number_of_entries_kept] = m_end_marker_slot_indices[i];
+							number_of_entries_kept += 1;
+						}
+					}
+					m_end_marker_slot_indices.resize(number_of_entries_kept);
+					m_end_markers_need_compaction = false;
+				}
+
+				/* Then we sort the (still in use) unindexed slots and merge them in. */
+				m_merge_buffer.clear();
+				for (size_t i = 0; m_unindexed_slot_indices.size() > i; i += 1) {
+					CHashKey1 slot_index = m_unindexed_slot_indices[i];
+					CSlot& slot_ref = slot(slot_index);
+					slot_ref.m_unindexed = false;
+					slot_ref.m_indexed_as = sc_not_indexed;
+					if (slot_ref.m_in_use) {
+						CMergeEntry entry;
+						entry.m_slot_index = slot_index;
+						if (position_of_ref(item_from_slot(slot_ref), entry.m_position)) {
+							m_merge_buffer.push_back(entry);
+							slot_ref.m_indexed_as = sc_indexed_by_position;
+						}
+						else {
+							m_end_marker_slot_indices.push_back(slot_index);
+							slot_ref.m_indexed_as = sc_indexed_as_end_marker;
+						}
+					}
+				}
+				m_unindexed_slot_indices.clear();
+				if (!m_merge_buffer.empty()) {
+					std::sort(m_merge_buffer.begin(), m_merge_buffer.end(), CMergeEntryLess());
+					size_t old_size = m_positions.size();
+					m_positions.resize(old_size + m_merge_buffer.size());
+					m_position_slot_indices.resize(m_positions.size());
+					/* merge from the back so that no additional storage is required */
+					size_t i = old_size;
+					size_t j = m_merge_buffer.size();
+					size_t k = m_positions.size();
+					while (0 < j) {
+						if ((0 < i) && (m_merge_buffer[j - 1].m_position < m_positions[i - 1])) {
+							m_positions[k - 1] = m_positions[i - 1];
+							m_position_slot_indices[k - 1] = m_position_slot_indices[i - 1];
+							i -= 1;
+						}
+						else {
+							m_positions[k - 1] = m_merge_buffer[j - 1].m_position;
+							m_position_slot_indices[k - 1] = m_merge_buffer[j - 1].m_slot_index;
+							j -= 1;
+						}
+						k -= 1;
+					}
+				}
+			}
+			/* Makes all the items (that are in use) end markers in the position index. */
+			void reindex_all_as_end_markers() {
+				for (size_t i = 0; m_unindexed_slot_indices.size() > i; i += 1) {
+					slot(m_unindexed_slot_indices[i]).m_unindexed = false;
+				}
+				m_unindexed_slot_indices.clear();
+				m_positions.clear();
+				m_position_slot_indices.clear();
+				m_end_marker_slot_indices.clear();
+				m_positions_need_compaction = false;
+				m_end_markers_need_compaction = false;
+				for (CHashKey1 slot_index = 0; m_number_of_slots_used > slot_index; slot_index += 1) {
+					CSlot& slot_ref = slot(slot_index);
+					if (slot_ref.m_in_use) {
+						m_end_marker_slot_indices.push_back(slot_index);
+						slot_ref.m_indexed_as = sc_indexed_as_end_marker;
+					}
+					else {
+						slot_ref.m_indexed_as = sc_not_indexed;
+					}
+				}
+			}
+
+			/* The following may only be used (by the registry) after the index is settled. */
+			size_t number_of_indexed_positions() const { return m_positions.size(); }
+			/* Returns the offset (in the index) of the first entry whose position is not less than the given position. */
+			size_t lower_position_bound(size_t position) const {
+				return (std::lower_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin());
+			}
+			/* Returns the offset (in the index) of the first entry whose position is greater than the given position. */
+			size_t upper_position_bound(size_t position) const {
+				return (std::upper_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin());
+			}
+			size_t indexed_position(size_t offset) const { return m_positions[offset]; }
+			CHashKey1 indexed_slot_index(size_t offset) const { return m_position_slot_indices[offset]; }
+			_TItem& indexed_item(size_t offset) const { return item(m_position_slot_indices[offset]); }
+			/* Adds shift to the positions of the entries at offsets [first_offset, end_offset). The shift may be negative. */
+			void shift_indexed_positions(size_t first_offset, size_t end_offset, mse::CInt shift) {
+				if (first_offset >= end_offset) { return; }
+				/* Unsigned arithmetic wraps, so adding the two's complement of a negative shift subtracts it. */
+				const size_t delta = size_t(ptrdiff_t(int(shift)));
+				size_t* positions = &(m_positions[first_offset]);
+				const size_t count = end_offset - first_offset;
+				for (size_t i = 0; count > i; i += 1) {
+					positions[i] += delta;
+				}
+			}
+			/* Restores the ordering of the index (if necessary) after the entries at offsets [first_offset, end_offset) have
+			been shifted. */
+			void restore_position_order(size_t first_offset, size_t end_offset) {
+				if (first_offset >= end_offset) { return; }
+				if ((0 == first_offset) && (m_positions.size() == end_offset)) {
+					if (!std::is_sorted(m_positions.begin(), m_positions.end())) { resort_position_index(); }
+					return;
 				}
-				for (auto it = m_aux_mm_iterator_shptrs.begin(); m_aux_mm_iterator_shptrs.end() != it; it++) {
-					(*it).second->sync_iterator_to_index();
+				/* A shifted block can only end up out of order if it overtook its neighbors. */
+				if (((0 < first_offset) && (m_positions[first_offset - 1] > m_positions[first_offset]))
+					|| ((m_positions.size() > end_offset) && (m_positions[end_offset - 1] > m_positions[end_offset]))) {
+					resort_position_index();
 				}
 			}
+			/* Returns whether any entries have positions in the inclusive range [first_position, last_position]. */
+			bool has_indexed_positions_in_range(size_t first_position, size_t last_position) const {
+				if (m_positions.empty() || (m_positions.back() < first_position) || (m_positions.front() > last_position)) { return false; }
+				return (lower_position_bound(first_position) < upper_position_bound(last_position));
+			}
+			/* Replaces the position of each entry with the one given by map_ref(position, new_position). Entries for which map_ref
+			returns false are moved to the end marker list. map_ref is called in order of (increasing) position. */
+			template<class _TMapFunction>
+			void remap_positions(_TMapFunction& map_ref) {
+				size_t number_of_entries_kept = 0;
+				for (size_t i = 0; m_positions.size() > i; i += 1) {
+					size_t new_position = 0;
+					if (map_ref(m_positions[i], new_position)) {
+						m_positions[number_of_entries_kept] = new_position;
+						m_position_slot_indices[number_of_entries_kept] = m_position_slot_indices[i];
+						number_of_entries_kept += 1;
+					}
+					else {
+						CSlot& slot_ref = slot(m_position_slot_indices[i]);
+						slot_ref.m_indexed_as = sc_indexed_as_end_marker;
+						if (slot_ref.m_unindexed) { m_end_markers_need_compaction = true; }
+						m_end_marker_slot_indices.push_back(m_position_slot_indices[i]);
+					}
+				}
+				m_positions.resize(number_of_entries_kept);
+				m_position_slot_indices.resize(number_of_entries_kept);
+				restore_position_order(0, m_positions.size());
+			}
+			/* Moves the entries at offsets [first_offset, end_offset) to the end marker list. */
+			void move_indexed_entries_to_end_markers(size_t first_offset, size_t end_offset) {
+				if (first_offset >= end_offset) { return; }
+				for (size_t i = first_offset; end_offset > i; i += 1) {
+					slot(m_position_slot_indices[i]).m_indexed_as = sc_indexed_as_end_marker;
+				}
+				m_end_marker_slot_indices.insert(m_end_marker_slot_indices.end(), m_position_slot_indices.begin() + first_offset, m_position_slot_indices.begin() + end_offset);
+				m_positions.erase(m_positions.begin() + first_offset, m_positions.begin() + end_offset);
+				m_position_slot_indices.erase(m_position_slot_indices.begin() + first_offset, m_position_slot_indices.begin() + end_offset);
+			}
+			CSlotIndexList& end_marker_slot_indices() { return m_end_marker_slot_indices; }
+
+			size_t synced_epoch(CHashKey1 slot_index) const { return slot(slot_index).m_synced_epoch; }
+			void set_synced_epoch(CHashKey1 slot_index, size_t epoch) { slot(slot_index).m_synced_epoch = epoch; }
+			size_t synced_storage_generation(CHashKey1 slot_index) const { return slot(slot_index).m_synced_storage_generation; }
+			void set_synced_storage_generation(CHashKey1 slot_index, size_t generation) { slot(slot_index).m_synced_storage_generation = generation; }
+			void set_all_synced_epochs(size_t epoch, size_t storage_generation) {
+				for (CHashKey1 slot_index = 0; m_number_of_slots_used > slot_index; slot_index += 1) {
+					slot(slot_index).m_synced_epoch = epoch;
+					slot(slot_index).m_synced_storage_generation = storage_generation;
+				}
+			}
+
+		private:
+			TMMIteratorSlab(const TMMIteratorSlab&);
+			TMMIteratorSlab& operator=(const TMMIteratorSlab&);
+
+			static const size_t sc_chunk_size = 64;
+			static const CHashKey1 sc_no_slot = CHashKey1(-1);
+			static const unsigned char sc_not_indexed = 0;
+			static const unsigned char sc_indexed_by_position = 1;
+			static const unsigned char sc_indexed_as_end_marker = 2;
+			class CSlot {
+			public:
+				CSlot() : m_next_free_slot(sc_no_slot), m_synced_epoch(0), m_synced_storage_generation(0), m_in_use(false), m_unindexed(false), m_indexed_as(sc_not_indexed) {}
+				typename std::aligned_storage<sizeof(_TItem), std::alignment_of<_TItem>::value>::type m_storage;
+				CHashKey1 m_next_free_slot;
+				/* The (registry's) mutation log epoch the slot's item was last brought up to date at. */
+				size_t m_synced_epoch;
+				/* The (registry's) storage generation the slot's item's base iterator was last derived at. */
+				size_t m_synced_storage_generation;
+				bool m_in_use;
+				bool m_unindexed;
+				/* Which list, if any, currently has an entry for the slot. */
+				unsigned char m_indexed_as;
+			};
+			class CChunk {
+			public:
+				CSlot m_slots[sc_chunk_size];
+			};
+			CSlot& slot(CHashKey1 slot_index) const {
+				return m_chunks[slot_index / sc_chunk_size]->m_slots[slot_index % sc_chunk_size];
+			}
+			static _TItem& item_from_slot(CSlot& slot_ref) {
+				return (*reinterpret_cast<_TItem*>(&(slot_ref.m_storage)));
+			}
+			class CMergeEntry {
+			public:
+				size_t m_position;
+				CHashKey1 m_slot_index;
+			};
+			class CMergeEntryLess {
+			public:
+				bool operator()(const CMergeEntry& a, const CMergeEntry& b) const { return (a.m_position < b.m_position); }
+			};
+			void resort_position_index() {
+				m_merge_buffer.resize(m_positions.size());
+				for (size_t i = 0; m_positions.size() > i; i += 1) {
+					m_merge_buffer[i].m_position = m_positions[i];
+					m_merge_buffer[i].m_slot_index = m_position_slot_indices[i];
+				}
+				std::stable_sort(m_merge_buffer.begin(), m_merge_buffer.end(), CMergeEntryLess());
+				for (size_t i = 0; m_positions.size() > i; i += 1) {
+					m_positions[i] = m_merge_buffer[i].m_position;
+					m_position_slot_indices[i] = m_merge_buffer[i].m_slot_index;
+				}
+			}
+
+			std::vector<std::unique_ptr<CChunk>> m_chunks;
+			CHashKey1 m_first_free_slot;
+			CHashKey1 m_number_of_slots_used;
+			size_t m_number_of_items;
+
+			std::vector<size_t> m_positions;
+			CSlotIndexList m_position_slot_indices;
+			CSlotIndexList m_end_marker_slot_indices;
+			CSlotIndexList m_unindexed_slot_indices;
+			std::vector<CMergeEntry> m_merge_buffer;
+			bool m_positions_need_compaction;
+			bool m_end_markers_need_compaction;
+		};
+
+		class mm_iterator_set_type {
+		public:
+			typedef TMMIteratorSlab<mm_const_iterator_type> CMMConstIterators;
+			typedef TMMIteratorSlab<mm_iterator_type> CMMIterators;
+
+			mm_iterator_set_type(_Myt& owner_ref) : m_owner_ref(owner_ref), m_applying_fixups(false), m_epoch(0), m_first_logged_epoch(0), m_storage_generation(0)
+				, m_batch_depth(0), m_number_of_tracked_ranges(0) {}
+			void reset() {
+				note_iterators_visited(m_aux_mm_const_iterators.size() + m_aux_mm_iterators.size());
+				CFixupScope fixup_scope(*this);
+				CResetFunction func;
+				m_aux_mm_const_iterators.for_each(func);
+				m_aux_mm_iterators.for_each(func);
+				m_aux_mm_const_iterators.reindex_all_as_end_markers();
+				m_aux_mm_iterators.reindex_all_as_end_markers();
+				if (0 < m_batch_depth) { reset_batch_map(); }
+				/* All the iterators are now up to date, so the mutation log can be discarded. */
+				m_aux_mm_const_iterators.set_all_synced_epochs(m_epoch, m_storage_generation);
+				m_aux_mm_iterators.set_all_synced_epochs(m_epoch, m_storage_generation);
+				m_first_logged_epoch = m_epoch;
+				/* Like the iterators, the tracked ranges end up at the end of the vector (empty). */
+				if (has_tracked_ranges()) { collapse_tracked_ranges_to(m_owner_ref.size()); }
+			}
+			/* Called when the vector's storage has been reallocated. Rather than rederiving the base iterators of all the
+			registered iterators right away, each iterator rederives its base iterator (from its index) the next time it is
+			accessed. */
+			void sync_iterators_to_index() {
+				m_storage_generation += 1;
+			}
+			/* The registered iterators are kept ordered by position (in the slabs' position indexes), so the range operations
+			only need to visit the index entries that are actually affected. The iterators themselves aren't updated right away.
+			Instead the operation is recorded in the mutation log and each iterator replays the operations it missed the next
+			time it is accessed. End markers are effectively symbolic. They are just resynced to the end of the vector when they
+			are accessed, so operations that only affect the end markers (like push_back() and pop_back() usually do) don't need to
+			be recorded at all. */
 			void invalidate_inclusive_range(mse::CSize_t start_index, mse::CSize_t end_index) {
-				for (auto it = m_aux_mm_const_iterator_shptrs.begin(); m_aux_mm_const_iterator_shptrs.end() != it; it++) {
-					(*it).second->invalidate_inclusive_range(start_index, end_index);
+				if (has_tracked_ranges()) { invalidate_inclusive_range_in_tracked_ranges(mse::as_a_size_t(start_index), mse::as_a_size_t(end_index)); }
+				if (!any_item_pointing_iterators_in_range(start_index, end_index)) { return; }
+				make_room_in_mutation_log();
+				if (0 < m_batch_depth) {
+					add_to_batch_map(mse::as_a_size_t(start_index), mse::as_a_size_t(end_index), 0, true);
 				}
-				for (auto it = m_aux_mm_iterator_shptrs.begin(); m_aux_mm_iterator_shptrs.end() != it; it++) {
-					(*it).second->invalidate_inclusive_range(start_index, end_index);
+				else {
+					invalidate_inclusive_range_in(m_aux_mm_const_iterators, start_index, end_index);
+					invalidate_inclusive_range_in(m_aux_mm_iterators, start_index, end_index);
 				}
+				CMutationLogEntry entry;
+				entry.m_first = mse::as_a_size_t(start_index);
+				entry.m_last = mse::as_a_size_t(end_index);
+				entry.m_shift = 0;
+				entry.m_invalidates = true;
+				append_to_mutation_log(entry);
 			}
 			void shift_inclusive_range(mse::CSize_t start_index, mse::CSize_t end_index, mse::CInt shift) {
-				for (auto it = m_aux_mm_const_iterator_shptrs.begin(); m_aux_mm_const_iterator_shptrs.end() != it; it++) {
-					(*it).second->shift_inclusive_range(start_index, end_index, shift);
+				if (has_tracked_ranges()) { shift_inclusive_range_in_tracked_ranges(mse::as_a_size_t(start_index), mse::as_a_size_t(end_index), size_t(ptrdiff_t(int(shift)))); }
+				if (!any_item_pointing_iterators_in_range(start_index, end_index)) { return; }
+				make_room_in_mutation_log();
+				if (0 < m_batch_depth) {
+					add_to_batch_map(mse::as_a_size_t(start_index), mse::as_a_size_t(end_index), size_t(ptrdiff_t(int(shift))), false);
+				}
+				else {
+					shift_inclusive_range_in(m_aux_mm_const_iterators, start_index, end_index, shift);
+					shift_inclusive_range_in(m_aux_mm_iterators, start_index, end_index, shift);
 				}
-				for (auto it = m_aux_mm_iterator_shptrs.begin(); m_aux_mm_iterator_shptrs.end() != it; it++) {
-					(*it).second->shift_inclusive_range(start_index, end_index, shift);
+				CMutationLogEntry entry;
+				entry.m_first = mse::as_a_size_t(start_index);
+				entry.m_last = mse::as_a_size_t(end_index);
+				entry.m_shift = size_t(ptrdiff_t(int(shift)));
+				entry.m_invalidates = false;
+				append_to_mutation_log(entry);
+			}
+			bool empty() const { return (m_aux_mm_const_iterators.empty() && m_aux_mm_iterators.empty()); }
+
+			/* While a batch is in progress the position indexes aren't updated by each operation. Instead the operations are
+			composed into a single piecewise map (from pre-batch positions to current positions) which is applied to the
+			indexes in one pass when the (outermost) batch ends. (The operations are still recorded in the mutation log as
+			usual.) */
+			void begin_batch() {
+				if (0 == m_batch_depth) { reset_batch_map(); }
+				m_batch_depth += 1;
+			}
+			void end_batch() {
+				assert(0 < m_batch_depth);
+				m_batch_depth -= 1;
+				if (0 == m_batch_depth) {
+					apply_batch_map();
+					m_batch_map.clear();
 				}
 			}
+			void note_position_change(const mm_const_iterator_type& item_cref) {
+				if (!m_applying_fixups) { m_aux_mm_const_iterators.mark_unindexed(item_cref.m_registry_slot_index); }
+			}
+			void note_position_change(const mm_iterator_type& item_cref) {
+				if (!m_applying_fixups) { m_aux_mm_iterators.mark_unindexed(item_cref.m_registry_slot_index); }
+			}
 
-			mm_const_iterator_handle_type allocate_new_const_item_pointer() {
-				auto shptr = std::shared_ptr<mm_const_iterator_type>(new mm_const_iterator_type(m_owner_ref));
-				auto key = m_next_available_key; m_next_available_key++;
-				mm_const_iterator_handle_type retval(key, shptr);
-				typename CMMConstIterators::value_type new_item(key, shptr);
-				m_aux_mm_const_iterator_shptrs.insert(new_item);
-				return retval;
+			/* These just update the instrumentation counts (when MSE_MSEVECTOR_INSTRUMENTATION is defined). */
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+			void note_iterators_visited(size_t count) {
+				m_owner_ref.m_aux_state.m_instrumentation_counts.m_iterators_visited += count;
+				msevector_global_instrumentation::note_iterators_visited(count);
+			}
+			void note_live_ipointers_change(size_t number_allocated, size_t number_released) {
+				msevector_instrumentation_counts& counts_ref = m_owner_ref.m_aux_state.m_instrumentation_counts;
+				counts_ref.m_live_ipointers = counts_ref.m_live_ipointers + number_allocated - number_released;
+				if (counts_ref.m_peak_live_ipointers < counts_ref.m_live_ipointers) { counts_ref.m_peak_live_ipointers = counts_ref.m_live_ipointers; }
+				for (size_t i = 0; number_allocated > i; i += 1) { msevector_global_instrumentation::note_ipointer_allocated(); }
+				for (size_t i = 0; number_released > i; i += 1) { msevector_global_instrumentation::note_ipointer_released(); }
+			}
+#else /*MSE_MSEVECTOR_INSTRUMENTATION*/
+			void note_iterators_visited(size_t /*count*/) {}
+			void note_live_ipointers_change(size_t /*number_allocated*/, size_t /*number_released*/) {}
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+
+			mm_const_iterator_handle_type allocate_new_const_item_pointer(cipointer* handle_owner_ptr) {
+				note_live_ipointers_change(1, 0);
+				CHashKey1 slot_index = m_aux_mm_const_iterators.allocate(m_owner_ref);
+				m_aux_mm_const_iterators.item(slot_index).m_registry_slot_index = slot_index;
+				m_aux_mm_const_iterators.item(slot_index).m_handle_owner_ptr = handle_owner_ptr;
+				m_aux_mm_const_iterators.set_synced_epoch(slot_index, m_epoch);
+				m_aux_mm_const_iterators.set_synced_storage_generation(slot_index, m_storage_generation);
+				return mm_const_iterator_handle_type(slot_index);
 			}
 			void release_const_item_pointer(mm_const_iterator_handle_type handle) {
-				auto it = m_aux_mm_const_iterator_shptrs.find(handle.m_key);
-				if (m_aux_mm_const_iterator_shptrs.end() != it) {
-					m_aux_mm_const_iterator_shptrs.erase(it);
+				if (m_aux_mm_const_iterators.is_in_use(handle.m_key)) {
+					m_aux_mm_const_iterators.release(handle.m_key);
+					note_live_ipointers_change(0, 1);
 				}
 				else {
 					/* Do we need to throw here? */
@@ -1111,18 +2086,19 @@ namespace mse {
 				}
 			}
 
-			mm_iterator_handle_type allocate_new_item_pointer() {
-				auto shptr = std::shared_ptr<mm_iterator_type>(new mm_iterator_type(m_owner_ref));
-				auto key = m_next_available_key; m_next_available_key++;
-				mm_iterator_handle_type retval(key, shptr);
-				typename CMMIterators::value_type new_item(key, shptr);
-				m_aux_mm_iterator_shptrs.insert(new_item);
-				return retval;
+			mm_iterator_handle_type allocate_new_item_pointer(ipointer* handle_owner_ptr) {
+				note_live_ipointers_change(1, 0);
+				CHashKey1 slot_index = m_aux_mm_iterators.allocate(m_owner_ref);
+				m_aux_mm_iterators.item(slot_index).m_registry_slot_index = slot_index;
+				m_aux_mm_iterators.item(slot_index).m_handle_owner_ptr = handle_owner_ptr;
+				m_aux_mm_iterators.set_synced_epoch(slot_index, m_epoch);
+				m_aux_mm_iterators.set_synced_storage_generation(slot_index, m_storage_generation);
+				return mm_iterator_handle_type(slot_index);
 			}
 			void release_item_pointer(mm_iterator_handle_type handle) {
-				auto it = m_aux_mm_iterator_shptrs.find(handle.m_key);
-				if (m_aux_mm_iterator_shptrs.end() != it) {
-					m_aux_mm_iterator_shptrs.erase(it);
+				if (m_aux_mm_iterators.is_in_use(handle.m_key)) {
+					m_aux_mm_iterators.release(handle.m_key);
+					note_live_ipointers_change(0, 1);
 				}
 				else {
 					/* Do we need to throw here? */
@@ -1130,72 +2106,872 @@ namespace mse {
 				}
 			}
 			void release_all_item_pointers() {
-				m_aux_mm_iterator_shptrs.clear();
+				note_live_ipointers_change(0, m_aux_mm_iterators.size());
+				m_aux_mm_iterators.release_all();
+			}
+			/* The tracked ranges (of iranges). Each range is a single registry entry, but its beginning and end positions are kept
+			in separate position indexes (each sorted by position, like the iterator slabs' indexes), so a fixup only visits the
+			range ends it actually moves. An empty range has no end index entry (its end is just its beginning), so its ends
+			can't be separated. */
+			size_t allocate_tracked_range(size_t begin_position, size_t end_position) {
+				size_t range_index = m_tracked_range_begin_entries.size();
+				if (!m_free_tracked_range_indices.empty()) {
+					range_index = m_free_tracked_range_indices.back();
+					m_free_tracked_range_indices.pop_back();
+				}
+				else {
+					m_tracked_range_begin_entries.push_back(size_t(sc_no_tracked_range_entry));
+					m_tracked_range_end_entries.push_back(size_t(sc_no_tracked_range_entry));
+				}
+				m_number_of_tracked_ranges += 1;
+				insert_tracked_range_entries(range_index, begin_position, end_position);
+				return range_index;
+			}
+			void release_tracked_range(size_t range_index) {
+				if ((m_tracked_range_begin_entries.size() <= range_index) || (sc_no_tracked_range_entry == m_tracked_range_begin_entries[range_index])) {
+					throw(std::out_of_range("invalid handle - void release_tracked_range(size_t range_index) - msevector::mm_iterator_set_type"));
+				}
+				m_number_of_tracked_ranges -= 1;
+				if (0 == m_number_of_tracked_ranges) {
+					m_tracked_range_begin_index.clear();
+					m_tracked_range_end_index.clear();
+					m_tracked_range_begin_entries.clear();
+					m_tracked_range_end_entries.clear();
+					m_free_tracked_range_indices.clear();
+				}
+				else {
+					erase_tracked_range_entries(range_index);
+					m_free_tracked_range_indices.push_back(range_index);
+				}
+			}
+			size_t tracked_range_begin(size_t range_index) const {
+				return m_tracked_range_begin_index.m_positions[m_tracked_range_begin_entries[range_index]];
+			}
+			size_t tracked_range_end(size_t range_index) const {
+				const size_t end_entry = m_tracked_range_end_entries[range_index];
+				return (sc_no_tracked_range_entry == end_entry) ? tracked_range_begin(range_index) : m_tracked_range_end_index.m_positions[end_entry];
+			}
+			void set_tracked_range(size_t range_index, size_t begin_position, size_t end_position) {
+				erase_tracked_range_entries(range_index);
+				insert_tracked_range_entries(range_index, begin_position, end_position);
 			}
-			mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) const {
-				return (*(handle.m_shptr));
+			bool has_tracked_ranges() const { return (0 < m_number_of_tracked_ranges); }
+
+			mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) {
+				mm_const_iterator_type& item_ref = m_aux_mm_const_iterators.item(handle.m_key);
+				bring_up_to_date(m_aux_mm_const_iterators, item_ref);
+				return item_ref;
 			}
 			mm_iterator_type &item_pointer(mm_iterator_handle_type handle) {
-				return (*(handle.m_shptr));
+				mm_iterator_type& item_ref = m_aux_mm_iterators.item(handle.m_key);
+				bring_up_to_date(m_aux_mm_iterators, item_ref);
+				return item_ref;
 			}
 
 		private:
-			void release_all_const_item_pointers() {
-				m_aux_mm_const_iterator_shptrs.clear();
+			class CResetFunction {
+			public:
+				template<class _TItem> void operator()(_TItem& item_ref) { item_ref.reset(); }
+			};
+			class CSyncFunction {
+			public:
+				void operator()(mm_const_iterator_type& item_ref) { item_ref.sync_const_iterator_to_index(); }
+				void operator()(mm_iterator_type& item_ref) { item_ref.sync_iterator_to_index(); }
+			};
+			/* Used when settling a slab's position index. The iterator is brought up to date before its position is read. */
+			template<class _TSlab>
+			class TPositionOfFunction {
+			public:
+				TPositionOfFunction(mm_iterator_set_type& set_ref, _TSlab& slab_ref) : m_set_ref(set_ref), m_slab_ref(slab_ref) {}
+				template<class _TItem> bool operator()(_TItem& item_ref, size_t& position_ref) {
+					m_set_ref.bring_up_to_date(m_slab_ref, item_ref);
+					if (item_ref.m_points_to_an_item) {
+						position_ref = mse::as_a_size_t(item_ref.m_index);
+						return true;
+					}
+					return false;
+				}
+			private:
+				mm_iterator_set_type& m_set_ref;
+				_TSlab& m_slab_ref;
+			};
+			template<class _TSlab>
+			void settle(_TSlab& slab_ref) {
+				TPositionOfFunction<_TSlab> position_of(*this, slab_ref);
+				slab_ref.settle_position_index(position_of);
+			}
+			/* While the registry is adjusting the positions of its iterators it keeps the position index up to date itself, so
+			the iterators' own change notifications are suppressed. */
+			class CFixupScope {
+			public:
+				CFixupScope(mm_iterator_set_type& set_ref) : m_set_ref(set_ref), m_previous_value(set_ref.m_applying_fixups) { m_set_ref.m_applying_fixups = true; }
+				~CFixupScope() { m_set_ref.m_applying_fixups = m_previous_value; }
+			private:
+				mm_iterator_set_type& m_set_ref;
+				bool m_previous_value;
+			};
+
+			/* A (position, shift) record of a shift_inclusive_range() or invalidate_inclusive_range() operation. */
+			class CMutationLogEntry {
+			public:
+				size_t m_first;
+				size_t m_last;
+				/* negative shifts are stored in two's complement form */
+				size_t m_shift;
+				bool m_invalidates;
+			};
+			static const size_t sc_min_mutation_log_capacity = 16;
+			static const size_t sc_max_mutation_log_capacity = 4096;
+
+			/* This must be called before an operation modifies the position indexes, as bringing all the iterators up to date
+			uses the indexes. */
+			void make_room_in_mutation_log() {
+				if (m_mutation_log.size() <= m_epoch - m_first_logged_epoch) {
+					if (0 < m_batch_depth) {
+						/* the indexes need to be current */
+						apply_batch_map();
+						reset_batch_map();
+					}
+					/* The log is full, so we bring all the iterators up to date and start over. Bringing all the iterators up to
+					date costs time proportional to the number of iterators, so the log capacity is sized accordingly (within
+					limits), which keeps the amortized cost per mutation roughly constant. */
+					bring_all_up_to_date();
+					size_t target_capacity = m_aux_mm_const_iterators.size() + m_aux_mm_iterators.size();
+					if (sc_min_mutation_log_capacity > target_capacity) { target_capacity = sc_min_mutation_log_capacity; }
+					if (sc_max_mutation_log_capacity < target_capacity) { target_capacity = sc_max_mutation_log_capacity; }
+					if (m_mutation_log.size() < target_capacity) { m_mutation_log.resize(target_capacity); }
+				}
+			}
+			void append_to_mutation_log(const CMutationLogEntry& entry) {
+				assert(m_mutation_log.size() > m_epoch - m_first_logged_epoch);
+				m_mutation_log[m_epoch % m_mutation_log.size()] = entry;
+				m_epoch += 1;
+			}
+			bool any_item_pointing_iterators_in_range(mse::CSize_t start_index, mse::CSize_t end_index) {
+				/* The indexes aren't current during a batch. */
+				if (0 < m_batch_depth) { return !empty(); }
+				if (!m_aux_mm_const_iterators.empty()) {
+					settle(m_aux_mm_const_iterators);
+					if (m_aux_mm_const_iterators.has_indexed_positions_in_range(mse::as_a_size_t(start_index), mse::as_a_size_t(end_index))) { return true; }
+				}
+				if (!m_aux_mm_iterators.empty()) {
+					settle(m_aux_mm_iterators);
+					if (m_aux_mm_iterators.has_indexed_positions_in_range(mse::as_a_size_t(start_index), mse::as_a_size_t(end_index))) { return true; }
+				}
+				return false;
+			}
+			/* Replays, on the given iterator, any logged operations that occurred since it was last brought up to date. */
+			template<class _TSlab, class _TItem>
+			void bring_up_to_date(_TSlab& slab_ref, _TItem& item_ref) {
+				const CHashKey1 slot_index = item_ref.m_registry_slot_index;
+				if (!(item_ref.m_points_to_an_item)) {
+					/* an end marker */
+					if ((m_owner_ref.size() != item_ref.m_index) || (m_storage_generation != slab_ref.synced_storage_generation(slot_index))) {
+						CFixupScope fixup_scope(*this);
+						item_ref.set_to_end_marker();
+					}
+					slab_ref.set_synced_epoch(slot_index, m_epoch);
+					slab_ref.set_synced_storage_generation(slot_index, m_storage_generation);
+					return;
+				}
+				const size_t synced_epoch = slab_ref.synced_epoch(slot_index);
+				if (m_epoch == synced_epoch) {
+					if (m_storage_generation != slab_ref.synced_storage_generation(slot_index)) {
+						sync_to_index(slab_ref, item_ref);
+					}
+					return;
+				}
+				assert(m_first_logged_epoch <= synced_epoch);
+				note_iterators_visited(1);
+				bool points_to_an_item = item_ref.m_points_to_an_item;
+				size_t index = mse::as_a_size_t(item_ref.m_index);
+				for (size_t epoch = synced_epoch; points_to_an_item && (m_epoch > epoch); epoch += 1) {
+					const CMutationLogEntry& entry = m_mutation_log[epoch % m_mutation_log.size()];
+					if ((entry.m_first <= index) && (entry.m_last >= index)) {
+						if (entry.m_invalidates) {
+							points_to_an_item = false;
+						}
+						else {
+							index += entry.m_shift;
+						}
+					}
+				}
+				CFixupScope fixup_scope(*this);
+				slab_ref.set_synced_epoch(slot_index, m_epoch);
+				if (points_to_an_item) {
+					item_ref.m_index = index;
+					sync_to_index(slab_ref, item_ref);
+				}
+				else {
+					/* End markers (including ones that were invalidated) simply track the end of the vector. */
+					item_ref.set_to_end_marker();
+					slab_ref.set_synced_storage_generation(slot_index, m_storage_generation);
+				}
+			}
+			/* Rederives the iterator's base iterator from its index. The iterators can be brought up to date in the middle of
+			an operation that shrinks the vector (i.e. after the elements have been removed, but before the operation has been
+			recorded), when the index of an iterator that the operation will shift or invalidate may be past the end of the
+			vector. In that case the base iterator is left stale, to be rederived when the iterator is next accessed (by which
+			time the operation will have been recorded and replayed). */
+			template<class _TSlab, class _TItem>
+			void sync_to_index(_TSlab& slab_ref, _TItem& item_ref) {
+				const CHashKey1 slot_index = item_ref.m_registry_slot_index;
+				if (m_owner_ref.size() >= mse::as_a_size_t(item_ref.m_index)) {
+					CSyncFunction sync_func;
+					sync_func(item_ref);
+					slab_ref.set_synced_storage_generation(slot_index, m_storage_generation);
+				}
+				else {
+					slab_ref.set_synced_storage_generation(slot_index, m_storage_generation - 1);
+				}
+			}
+			/* Brings all the iterators up to date directly from the position indexes (rather than by replaying the log) and
+			discards the log. */
+			void bring_all_up_to_date() {
+				bring_all_up_to_date_in(m_aux_mm_const_iterators);
+				bring_all_up_to_date_in(m_aux_mm_iterators);
+				m_first_logged_epoch = m_epoch;
+			}
+			template<class _TSlab>
+			void bring_all_up_to_date_in(_TSlab& slab_ref) {
+				if (slab_ref.empty()) { return; }
+				settle(slab_ref);
+				note_iterators_visited(slab_ref.number_of_indexed_positions());
+				CFixupScope fixup_scope(*this);
+				for (size_t i = 0; slab_ref.number_of_indexed_positions() > i; i += 1) {
+					CHashKey1 slot_index = slab_ref.indexed_slot_index(i);
+					if (m_epoch != slab_ref.synced_epoch(slot_index)) {
+						auto& item_ref = slab_ref.item(slot_index);
+						item_ref.m_index = slab_ref.indexed_position(i);
+						sync_to_index(slab_ref, item_ref);
+						slab_ref.set_synced_epoch(slot_index, m_epoch);
+					}
+				}
+				/* End markers aren't tracked by the log, so we check them all. */
+				typename _TSlab::CSlotIndexList& end_markers_ref = slab_ref.end_marker_slot_indices();
+				for (size_t i = 0; end_markers_ref.size() > i; i += 1) {
+					auto& item_ref = slab_ref.item(end_markers_ref[i]);
+					if ((m_owner_ref.size() != item_ref.m_index) || item_ref.m_points_to_an_item
+						|| (m_storage_generation != slab_ref.synced_storage_generation(end_markers_ref[i]))) {
+						item_ref.set_to_end_marker();
+					}
+					slab_ref.set_synced_epoch(end_markers_ref[i], m_epoch);
+					slab_ref.set_synced_storage_generation(end_markers_ref[i], m_storage_generation);
+				}
 			}
-			CMMConstIterators m_aux_mm_const_iterator_shptrs;
-			CMMIterators m_aux_mm_iterator_shptrs;
-			CHashKey1 m_next_available_key;
 
-			_Myt& m_owner_ref;
+			/* A piece of the batch map (or of any other piecewise position map). Pre-batch positions in [m_first, m_last] have
+			either been shifted by m_shift or invalidated. */
+			class CBatchMapPiece {
+			public:
+				size_t m_first;
+				size_t m_last;
+				/* negative shifts are stored in two's complement form */
+				size_t m_shift;
+				bool m_invalidated;
+			};
+			static const size_t sc_max_position = size_t(-1) / 2;
+			void reset_batch_map() {
+				m_batch_map.clear();
+				CBatchMapPiece piece;
+				piece.m_first = 0;
+				piece.m_last = sc_max_position;
+				piece.m_shift = 0;
+				piece.m_invalidated = false;
+				m_batch_map.push_back(piece);
+			}
+			/* Composes the given operation (expressed in current positions) with the batch map. */
+			void add_to_batch_map(size_t first, size_t last, size_t shift, bool invalidates) {
+				m_batch_map_buffer.clear();
+				for (size_t i = 0; m_batch_map.size() > i; i += 1) {
+					const CBatchMapPiece& piece = m_batch_map[i];
+					if (piece.m_invalidated) {
+						append_batch_map_piece(piece);
+						continue;
+					}
+					const size_t image_first = piece.m_first + piece.m_shift;
+					const size_t image_last = piece.m_last + piece.m_shift;
+					const size_t overlap_first = (image_first > first) ? image_first : first;
+					const size_t overlap_last = (image_last < last) ? image_last : last;
+					if (overlap_first > overlap_last) {
+						append_batch_map_piece(piece);
+						continue;
+					}
+					CBatchMapPiece sub_piece = piece;
+					if (image_first < overlap_first) {
+						sub_piece.m_last = piece.m_first + (overlap_first - image_first) - 1;
+						append_batch_map_piece(sub_piece);
+					}
+					sub_piece.m_first = piece.m_first + (overlap_first - image_first);
+					sub_piece.m_last = piece.m_first + (overlap_last - image_first);
+					if (invalidates) {
+						sub_piece.m_invalidated = true;
+					}
+					else {
+						sub_piece.m_shift = piece.m_shift + shift;
+					}
+					append_batch_map_piece(sub_piece);
+					if (overlap_last < image_last) {
+						sub_piece = piece;
+						sub_piece.m_first = piece.m_first + (overlap_last - image_first) + 1;
+						append_batch_map_piece(sub_piece);
+					}
+				}
+				std::swap(m_batch_map, m_batch_map_buffer);
+			}
+			/* Appends a piece to m_batch_map_buffer, coalescing it with the previous piece if they're equivalent. */
+			void append_batch_map_piece(const CBatchMapPiece& piece) {
+				append_map_piece(m_batch_map_buffer, piece);
+			}
+			/* Appends the piece to the map, coalescing it with the last piece where possible. */
+			static void append_map_piece(std::vector<CBatchMapPiece>& map_ref, const CBatchMapPiece& piece) {
+				if (!map_ref.empty()) {
+					CBatchMapPiece& back_ref = map_ref.back();
+					if ((back_ref.m_last + 1 == piece.m_first) && (back_ref.m_invalidated == piece.m_invalidated)
+						&& (back_ref.m_invalidated || (back_ref.m_shift == piece.m_shift))) {
+						back_ref.m_last = piece.m_last;
+						return;
+					}
+				}
+				map_ref.push_back(piece);
+			}
+			class CBatchMapFunction {
+			public:
+				CBatchMapFunction(const std::vector<CBatchMapPiece>& map_cref) : m_map_cref(map_cref), m_piece_index(0) {}
+				bool operator()(size_t position, size_t& new_position_ref) {
+					while (m_map_cref[m_piece_index].m_last < position) { m_piece_index += 1; }
+					const CBatchMapPiece& piece = m_map_cref[m_piece_index];
+					if (piece.m_invalidated) { return false; }
+					new_position_ref = position + piece.m_shift;
+					return true;
+				}
+			private:
+				const std::vector<CBatchMapPiece>& m_map_cref;
+				size_t m_piece_index;
+			};
+			void apply_batch_map() {
+				if ((1 == m_batch_map.size()) && (!m_batch_map.front().m_invalidated) && (0 == m_batch_map.front().m_shift)) { return; }
+				note_iterators_visited(m_aux_mm_const_iterators.number_of_indexed_positions() + m_aux_mm_iterators.number_of_indexed_positions());
+				CBatchMapFunction const_map(m_batch_map);
+				m_aux_mm_const_iterators.remap_positions(const_map);
+				CBatchMapFunction map(m_batch_map);
+				m_aux_mm_iterators.remap_positions(map);
+			}
 
-			friend class /*_Myt*/msevector<_Ty, _A>;
-		};
-		mutable mm_iterator_set_type m_mmitset;
+			/* Applies a piecewise map (from the current positions to the new positions, covering all positions in order) to
+			all the iterators in a single pass. Bulk operations (like erase_if()) use this rather than a separate fixup for
+			each affected range. The iterators are updated eagerly, so the mutation log is simply discarded. */
+			void apply_piecewise_map(const std::vector<CBatchMapPiece>& map_cref) {
+				if (has_tracked_ranges()) { apply_piecewise_map_to_tracked_ranges(map_cref); }
+				CBatchMapFunction const_map(map_cref);
+				CBatchMapFunction map(map_cref);
+				apply_position_map(const_map, map);
+			}
+			/* Maps each (item pointing) iterator's position to a new position given by the element positions array (indexed
+			by current position). Used by the operations that permute the elements (like sort()). */
+			class CPermutationMapFunction {
+			public:
+				CPermutationMapFunction(const std::vector<size_t>& new_positions_cref) : m_new_positions_cref(new_positions_cref) {}
+				bool operator()(size_t position, size_t& new_position_ref) {
+					new_position_ref = (m_new_positions_cref.size() > position) ? m_new_positions_cref[position] : position;
+					return true;
+				}
+			private:
+				const std::vector<size_t>& m_new_positions_cref;
+			};
+			void apply_permutation_map(const std::vector<size_t>& new_positions_cref) {
+				CPermutationMapFunction const_map(new_positions_cref);
+				CPermutationMapFunction map(new_positions_cref);
+				apply_position_map(const_map, map);
+			}
+			/* Appends (owner, position) pairs for the cipointers and ipointers pointing to items in the inclusive range [first,
+			last]. Used by splice() to move them along with their items. */
+			void collect_handle_owners_in_range(size_t first, size_t last, std::vector<std::pair<cipointer*, size_t> >& const_owners_ref
+				, std::vector<std::pair<ipointer*, size_t> >& owners_ref) {
+				if (empty()) { return; }
+				if (0 < m_batch_depth) {
+					/* the indexes need to be current */
+					apply_batch_map();
+					reset_batch_map();
+				}
+				collect_handle_owners_in_range_from(m_aux_mm_const_iterators, first, last, const_owners_ref);
+				collect_handle_owners_in_range_from(m_aux_mm_iterators, first, last, owners_ref);
+			}
+			template<class _TSlab, class _THandleOwner>
+			void collect_handle_owners_in_range_from(_TSlab& slab_ref, size_t first, size_t last, std::vector<std::pair<_THandleOwner*, size_t> >& owners_ref) {
+				if (slab_ref.empty()) { return; }
+				settle(slab_ref);
+				size_t lo = slab_ref.lower_position_bound(first);
+				size_t hi = slab_ref.upper_position_bound(last);
+				note_iterators_visited(hi - lo);
+				for (size_t i = lo; hi > i; i += 1) {
+					owners_ref.push_back(std::pair<_THandleOwner*, size_t>(slab_ref.item(slab_ref.indexed_slot_index(i)).m_handle_owner_ptr, slab_ref.indexed_position(i)));
+				}
+			}
+			/* The map function is called with each slab's indexed positions in increasing order, and returns false if the
+			iterator at the given position is to be invalidated. (A separate map function object is used for each slab.) */
+			template<class _TMapFunction>
+			void apply_position_map(_TMapFunction& const_map_ref, _TMapFunction& map_ref) {
+				if (empty()) { return; }
+				if (0 < m_batch_depth) {
+					/* the indexes need to be current */
+					apply_batch_map();
+					reset_batch_map();
+				}
+				bring_all_up_to_date();
+				apply_position_map_to(m_aux_mm_const_iterators, const_map_ref);
+				apply_position_map_to(m_aux_mm_iterators, map_ref);
+			}
+			template<class _TSlab, class _TMapFunction>
+			void apply_position_map_to(_TSlab& slab_ref, _TMapFunction& map_ref) {
+				if (slab_ref.empty()) { return; }
+				note_iterators_visited(slab_ref.number_of_indexed_positions());
+				const size_t original_number_of_end_markers = slab_ref.end_marker_slot_indices().size();
+				slab_ref.remap_positions(map_ref);
+				CFixupScope fixup_scope(*this);
+				CSyncFunction sync_func;
+				for (size_t i = 0; slab_ref.number_of_indexed_positions() > i; i += 1) {
+					auto& item_ref = slab_ref.item(slab_ref.indexed_slot_index(i));
+					if (slab_ref.indexed_position(i) != item_ref.m_index) {
+						item_ref.m_index = slab_ref.indexed_position(i);
+						sync_func(item_ref);
+						slab_ref.set_synced_storage_generation(slab_ref.indexed_slot_index(i), m_storage_generation);
+					}
+				}
+				/* the newly invalidated iterators */
+				typename _TSlab::CSlotIndexList& end_markers_ref = slab_ref.end_marker_slot_indices();
+				for (size_t i = original_number_of_end_markers; end_markers_ref.size() > i; i += 1) {
+					slab_ref.item(end_markers_ref[i]).set_to_end_marker();
+				}
+			}
 
-	public:
-		mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) const {
-			return m_mmitset.const_item_pointer(handle);
-		}
-		mm_iterator_type &item_pointer(mm_iterator_handle_type handle) {
-			return m_mmitset.item_pointer(handle);
-		}
+			template<class _TSlab>
+			void invalidate_inclusive_range_in(_TSlab& slab_ref, mse::CSize_t start_index, mse::CSize_t end_index) {
+				if (slab_ref.empty()) { return; }
+				settle(slab_ref);
+				size_t lo = slab_ref.lower_position_bound(mse::as_a_size_t(start_index));
+				size_t hi = slab_ref.upper_position_bound(mse::as_a_size_t(end_index));
+				/* invalidated iterators become end markers */
+				note_iterators_visited(hi - lo);
+				slab_ref.move_indexed_entries_to_end_markers(lo, hi);
+			}
+			template<class _TSlab>
+			void shift_inclusive_range_in(_TSlab& slab_ref, mse::CSize_t start_index, mse::CSize_t end_index, mse::CInt shift) {
+				if (slab_ref.empty()) { return; }
+				settle(slab_ref);
+				size_t lo = slab_ref.lower_position_bound(mse::as_a_size_t(start_index));
+				size_t hi = slab_ref.upper_position_bound(mse::as_a_size_t(end_index));
+				note_iterators_visited(hi - lo);
+				if (lo < hi) {
+					auto first_new_index = mse::CSize_t(slab_ref.indexed_position(lo)) + shift;
+					auto last_new_index = mse::CSize_t(slab_ref.indexed_position(hi - 1)) + shift;
+					if ((0 > first_new_index) || (m_owner_ref.size() < last_new_index)) {
+						throw(std::out_of_range("void shift_inclusive_range() - mm_iterator_set_type - msevector"));
+					}
+					slab_ref.shift_indexed_positions(lo, hi, shift);
+					slab_ref.restore_position_order(lo, hi);
+				}
+			}
 
-	private:
-		mm_const_iterator_handle_type allocate_new_const_item_pointer() const { return m_mmitset.allocate_new_const_item_pointer(); }
-		void release_const_item_pointer(mm_const_iterator_handle_type handle) const { m_mmitset.release_const_item_pointer(handle); }
-		void release_all_const_item_pointers() const { m_mmitset.release_all_const_item_pointers(); }
-		mm_iterator_handle_type allocate_new_item_pointer() const { return m_mmitset.allocate_new_item_pointer(); }
-		void release_item_pointer(mm_iterator_handle_type handle) const { m_mmitset.release_item_pointer(handle); }
-		void release_all_item_pointers() const { m_mmitset.release_all_item_pointers(); }
+			void release_all_const_item_pointers() {
+				note_live_ipointers_change(0, m_aux_mm_const_iterators.size());
+				m_aux_mm_const_iterators.release_all();
+			}
 
-	public:
-		class cipointer {
-		public:
-			typedef typename mm_const_iterator_type::iterator_category iterator_category;
-			typedef typename mm_const_iterator_type::value_type value_type;
-			typedef typename mm_const_iterator_type::difference_type difference_type;
-			typedef difference_type distance_type;	// retained
-			typedef typename mm_const_iterator_type::pointer pointer;
-			typedef typename mm_const_iterator_type::const_pointer const_pointer;
-			typedef typename mm_const_iterator_type::reference reference;
-			typedef typename mm_const_iterator_type::const_reference const_reference;
+			/* A position index of range ends. m_entries_of_ranges_ptr points to the (per range) array of the ranges' entry
+			indexes in this index, which are kept up to date as entries are inserted and removed. */
+			class CTrackedRangePositionIndex {
+			public:
+				void insert(size_t position, size_t range_index, std::vector<size_t>& entries_of_ranges_ref) {
+					const size_t entry_index = upper_bound(position);
+					m_positions.insert(m_positions.begin() + entry_index, position);
+					m_range_indices.insert(m_range_indices.begin() + entry_index, range_index);
+					renumber_from(entry_index, entries_of_ranges_ref);
+				}
+				void erase(size_t entry_index, std::vector<size_t>& entries_of_ranges_ref) {
+					entries_of_ranges_ref[m_range_indices[entry_index]] = sc_no_tracked_range_entry;
+					m_positions.erase(m_positions.begin() + entry_index);
+					m_range_indices.erase(m_range_indices.begin() + entry_index);
+					renumber_from(entry_index, entries_of_ranges_ref);
+				}
+				void renumber_from(size_t entry_index, std::vector<size_t>& entries_of_ranges_ref) {
+					for (size_t i = entry_index; m_range_indices.size() > i; i += 1) { entries_of_ranges_ref[m_range_indices[i]] = i; }
+				}
+				size_t lower_bound(size_t position) const { return std::lower_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin(); }
+				size_t upper_bound(size_t position) const { return std::upper_bound(m_positions.begin(), m_positions.end(), position) - m_positions.begin(); }
+				void clear() {
+					m_positions.clear();
+					m_range_indices.clear();
+				}
 
-			cipointer(const _Myt& owner_cref) : m_owner_cref(owner_cref) {
-				mm_const_iterator_handle_type handle = m_owner_cref.allocate_new_const_item_pointer();
-				m_handle_shptr = std::shared_ptr<mm_const_iterator_handle_type>(new mm_const_iterator_handle_type(handle));
+				std::vector<size_t> m_positions;
+				std::vector<size_t> m_range_indices;
+			};
+			static const size_t sc_no_tracked_range_entry = size_t(-1);
+
+			void insert_tracked_range_entries(size_t range_index, size_t begin_position, size_t end_position) {
+				m_tracked_range_begin_index.insert(begin_position, range_index, m_tracked_range_begin_entries);
+				if (begin_position < end_position) {
+					m_tracked_range_end_index.insert(end_position, range_index, m_tracked_range_end_entries);
+				}
 			}
-			cipointer(const cipointer& src_cref) : m_owner_cref(src_cref.m_owner_cref) {
-				mm_const_iterator_handle_type handle = m_owner_cref.allocate_new_const_item_pointer();
-				m_handle_shptr = std::shared_ptr<mm_const_iterator_handle_type>(new mm_const_iterator_handle_type(handle));
-				const_item_pointer() = src_cref.const_item_pointer();
+			void erase_tracked_range_entries(size_t range_index) {
+				m_tracked_range_begin_index.erase(m_tracked_range_begin_entries[range_index], m_tracked_range_begin_entries);
+				if (sc_no_tracked_range_entry != m_tracked_range_end_entries[range_index]) {
+					m_tracked_range_end_index.erase(m_tracked_range_end_entries[range_index], m_tracked_range_end_entries);
+				}
+			}
+			/* Makes all the tracked ranges empty ranges at the given position. The begin index stays sorted (as its positions are
+			all equal) and the end index is just emptied, so this doesn't allocate. */
+			void collapse_tracked_ranges_to(size_t position) {
+				std::fill(m_tracked_range_begin_index.m_positions.begin(), m_tracked_range_begin_index.m_positions.end(), position);
+				for (size_t i = 0; m_tracked_range_end_index.m_range_indices.size() > i; i += 1) {
+					m_tracked_range_end_entries[m_tracked_range_end_index.m_range_indices[i]] = sc_no_tracked_range_entry;
+				}
+				m_tracked_range_end_index.clear();
+			}
+			/* Replaces the contents of both indexes. (Unused range indexes are marked with sc_no_tracked_range_entry in
+			new_begins.) */
+			void rebuild_tracked_range_indexes(const std::vector<size_t>& new_begins, const std::vector<size_t>& new_ends) {
+				std::vector<std::pair<size_t, size_t> > begin_pairs;
+				std::vector<std::pair<size_t, size_t> > end_pairs;
+				for (size_t range_index = 0; m_tracked_range_begin_entries.size() > range_index; range_index += 1) {
+					if (sc_no_tracked_range_entry == m_tracked_range_begin_entries[range_index]) { continue; }
+					begin_pairs.push_back(std::pair<size_t, size_t>(new_begins[range_index], range_index));
+					if (new_begins[range_index] < new_ends[range_index]) {
+						end_pairs.push_back(std::pair<size_t, size_t>(new_ends[range_index], range_index));
+					}
+					m_tracked_range_end_entries[range_index] = sc_no_tracked_range_entry;
+				}
+				std::sort(begin_pairs.begin(), begin_pairs.end());
+				std::sort(end_pairs.begin(), end_pairs.end());
+				assign_tracked_range_index(m_tracked_range_begin_index, begin_pairs, m_tracked_range_begin_entries);
+				assign_tracked_range_index(m_tracked_range_end_index, end_pairs, m_tracked_range_end_entries);
+			}
+			static void assign_tracked_range_index(CTrackedRangePositionIndex& index_ref, const std::vector<std::pair<size_t, size_t> >& sorted_pairs
+				, std::vector<size_t>& entries_of_ranges_ref) {
+				index_ref.clear();
+				for (size_t i = 0; sorted_pairs.size() > i; i += 1) {
+					index_ref.m_positions.push_back(sorted_pairs[i].first);
+					index_ref.m_range_indices.push_back(sorted_pairs[i].second);
+					entries_of_ranges_ref[sorted_pairs[i].second] = i;
+				}
+			}
+
+			/* A range's beginning moves with the element at that position, and so does its end, except that elements inserted at
+			the end of a (nonempty) range don't become part of it. That is, an end is shifted if the element before it is. The
+			shifts (like those of the iterators) are always of the tail of the vector, so they preserve the order of the
+			indexes. */
+			void shift_inclusive_range_in_tracked_ranges(size_t first, size_t last, size_t shift) {
+				note_iterators_visited(shift_tracked_range_positions(m_tracked_range_begin_index, first, last, shift)
+					+ shift_tracked_range_positions(m_tracked_range_end_index, first + 1, last + 1, shift));
+			}
+			static size_t shift_tracked_range_positions(CTrackedRangePositionIndex& index_ref, size_t first, size_t last, size_t shift) {
+				/* (Operations near the end of the vector often don't affect any ranges.) */
+				if (index_ref.m_positions.empty() || (index_ref.m_positions.back() < first)) { return 0; }
+				const size_t lo = index_ref.lower_bound(first);
+				const size_t hi = index_ref.upper_bound(last);
+				size_t* positions = index_ref.m_positions.data();
+				for (size_t i = lo; hi > i; i += 1) { positions[i] += shift; }
+				return (hi - lo);
+			}
+			/* The invalidated (i.e. removed) positions are followed by a shift of the subsequent positions, so the ends that fell
+			in the removed range just move to its start. Ranges that end up empty lose their end index entry. */
+			void invalidate_inclusive_range_in_tracked_ranges(size_t first, size_t last) {
+				if (m_tracked_range_begin_index.m_positions.back() < first) {
+					/* (The beginning of every (nonempty) range precedes its end.) */
+					if (m_tracked_range_end_index.m_positions.empty() || (m_tracked_range_end_index.m_positions.back() <= first)) { return; }
+				}
+				const size_t begin_lo = m_tracked_range_begin_index.lower_bound(first);
+				const size_t begin_hi = m_tracked_range_begin_index.upper_bound(last);
+				for (size_t i = begin_lo; begin_hi > i; i += 1) { m_tracked_range_begin_index.m_positions[i] = first; }
+				const size_t end_lo = m_tracked_range_end_index.lower_bound(first + 1);
+				const size_t end_hi = m_tracked_range_end_index.upper_bound(last + 1);
+				note_iterators_visited((begin_hi - begin_lo) + (end_hi - end_lo));
+				size_t write_index = end_lo;
+				for (size_t i = end_lo; end_hi > i; i += 1) {
+					const size_t range_index = m_tracked_range_end_index.m_range_indices[i];
+					if (first == tracked_range_begin(range_index)) {
+						m_tracked_range_end_entries[range_index] = sc_no_tracked_range_entry;
+					}
+					else {
+						m_tracked_range_end_index.m_positions[write_index] = first;
+						m_tracked_range_end_index.m_range_indices[write_index] = range_index;
+						write_index += 1;
+					}
+				}
+				if (write_index < end_hi) {
+					CTrackedRangePositionIndex& index_ref = m_tracked_range_end_index;
+					index_ref.m_positions.erase(index_ref.m_positions.begin() + write_index, index_ref.m_positions.begin() + end_hi);
+					index_ref.m_range_indices.erase(index_ref.m_range_indices.begin() + write_index, index_ref.m_range_indices.begin() + end_hi);
+					index_ref.renumber_from(end_lo, m_tracked_range_end_entries);
+				}
+			}
+			static bool piece_ends_before(const CBatchMapPiece& piece, size_t position) { return (piece.m_last < position); }
+			/* The new beginning is the new position of the first surviving position at or after the old beginning, and the new
+			end follows the last surviving position before the old end. If the map reorders the two (as a rotation can), the
+			range becomes empty. */
+			void apply_piecewise_map_to_tracked_ranges(const std::vector<CBatchMapPiece>& map_cref) {
+				const size_t number_of_range_indexes = m_tracked_range_begin_entries.size();
+				std::vector<size_t> new_begins(number_of_range_indexes, size_t(sc_no_tracked_range_entry));
+				std::vector<size_t> new_ends(number_of_range_indexes, size_t(sc_no_tracked_range_entry));
+				for (size_t range_index = 0; number_of_range_indexes > range_index; range_index += 1) {
+					if (sc_no_tracked_range_entry == m_tracked_range_begin_entries[range_index]) { continue; }
+					const size_t begin_position = tracked_range_begin(range_index);
+					const size_t end_position = tracked_range_end(range_index);
+					size_t piece_index = std::lower_bound(map_cref.begin(), map_cref.end(), begin_position, piece_ends_before) - map_cref.begin();
+					while ((map_cref.size() > piece_index) && map_cref[piece_index].m_invalidated) { piece_index += 1; }
+					if (map_cref.size() <= piece_index) {
+						new_begins[range_index] = m_owner_ref.size();
+						new_ends[range_index] = m_owner_ref.size();
+						continue;
+					}
+					const size_t first_surviving = (map_cref[piece_index].m_first > begin_position) ? map_cref[piece_index].m_first : begin_position;
+					const size_t new_begin_position = first_surviving + map_cref[piece_index].m_shift;
+					size_t new_end_position = new_begin_position;
+					if (first_surviving < end_position) {
+						/* (The piece containing first_surviving isn't invalidated, so this search stops there at the latest.) */
+						size_t last_piece_index = std::lower_bound(map_cref.begin(), map_cref.end(), end_position - 1, piece_ends_before) - map_cref.begin();
+						while (map_cref[last_piece_index].m_invalidated) { last_piece_index -= 1; }
+						const size_t last_surviving = (map_cref[last_piece_index].m_last < end_position - 1) ? map_cref[last_piece_index].m_last : (end_position - 1);
+						new_end_position = last_surviving + map_cref[last_piece_index].m_shift + 1;
+						if (new_end_position < new_begin_position) { new_end_position = new_begin_position; }
+					}
+					new_begins[range_index] = new_begin_position;
+					new_ends[range_index] = new_end_position;
+				}
+				rebuild_tracked_range_indexes(new_begins, new_ends);
+			}
+
+			mutable CMMConstIterators m_aux_mm_const_iterators;
+			CMMIterators m_aux_mm_iterators;
+
+			_Myt& m_owner_ref;
+			bool m_applying_fixups;
+
+			/* The mutation log is a ring buffer. The entry for a given epoch is stored at (epoch % capacity). Entries from
+			m_first_logged_epoch up to (but not including) m_epoch are retained. */
+			std::vector<CMutationLogEntry> m_mutation_log;
+			size_t m_epoch;
+			size_t m_first_logged_epoch;
+			/* Incremented whenever the vector's storage is reallocated. */
+			size_t m_storage_generation;
+
+			size_t m_batch_depth;
+			std::vector<CBatchMapPiece> m_batch_map;
+			std::vector<CBatchMapPiece> m_batch_map_buffer;
+
+			CTrackedRangePositionIndex m_tracked_range_begin_index;
+			CTrackedRangePositionIndex m_tracked_range_end_index;
+			/* The (per range) indexes of the ranges' entries in the two position indexes. */
+			std::vector<size_t> m_tracked_range_begin_entries;
+			std::vector<size_t> m_tracked_range_end_entries;
+			std::vector<size_t> m_free_tracked_range_indices;
+			size_t m_number_of_tracked_ranges;
+
+			friend class /*_Myt*/msevector<_Ty, _A>;
+		};
+
+		class CUndoJournal;
+		/* The state that's only needed by vectors that use ss iterators, weak_ipointers, ipointers, iranges or savepoints.
+		The ss iterators and weak_ipointers need just the versions, so the (much larger) ipointer registry and the undo
+		journal are each allocated separately, when first needed. */
+		class CAuxiliaryState {
+		public:
+			CAuxiliaryState() : m_structure_version(0), m_buffer_generation(0) {}
+			/* Advanced by every mutation that inserts, removes or reorders elements (but not by reallocations or element
+			assignments). It's what weak_ipointers are validated against. */
+			size_t m_structure_version;
+			/* Advanced by every mutation that advances the structure version, and by reallocations. It's what ss iterators
+			validate their cached (base) iterators against. */
+			size_t m_buffer_generation;
+			std::unique_ptr<mm_iterator_set_type> m_mmitset_ptr;
+			std::unique_ptr<CUndoJournal> m_journal_ptr;
+		};
+		/* The auxiliary state is allocated when it's first needed (i.e. when the first ss iterator, weak_ipointer,
+		ipointer or irange is created), so a vector that never uses them carries just a (null) pointer, and the fixup
+		notifications from the mutation operations short-circuit to no-ops. Obtaining an ss iterator from a const vector
+		may allocate it, so it's published with a compare-and-swap, which makes that safe to do concurrently from multiple
+		threads. (Creating the first cipointer of a const vector, which also allocates the registry, still isn't.) */
+		class CLazyAuxiliaryState {
+		public:
+			CLazyAuxiliaryState() : m_aux_state_ptr(nullptr) {}
+			~CLazyAuxiliaryState() { delete aux_state_ptr(); }
+			CAuxiliaryState& allocated() {
+				CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr();
+				if (!aux_state_ptr) {
+					CAuxiliaryState* new_aux_state_ptr = new CAuxiliaryState();
+					if (m_aux_state_ptr.compare_exchange_strong(aux_state_ptr, new_aux_state_ptr, std::memory_order_acq_rel, std::memory_order_acquire)) {
+						aux_state_ptr = new_aux_state_ptr;
+					}
+					else {
+						/* (Another thread published its auxiliary state first.) */
+						delete new_aux_state_ptr;
+					}
+				}
+				return (*aux_state_ptr);
+			}
+			mm_iterator_set_type& allocated_mmitset(const _Myt& owner_cref) {
+				CAuxiliaryState& aux_state_ref = allocated();
+				if (!aux_state_ref.m_mmitset_ptr) {
+					aux_state_ref.m_mmitset_ptr.reset(new mm_iterator_set_type(const_cast<_Myt&>(owner_cref)));
+				}
+				return (*aux_state_ref.m_mmitset_ptr);
+			}
+			bool has_mmitset() const { return (nullptr != mmitset_ptr()); }
+			/* Only valid when the registry has been allocated. */
+			mm_iterator_set_type& mmitset() const { assert(mmitset_ptr()); return (*mmitset_ptr()); }
+			CUndoJournal* journal_ptr() const {
+				CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr();
+				return (aux_state_ptr) ? aux_state_ptr->m_journal_ptr.get() : nullptr;
+			}
+
+			void reset() {
+				note_structural_change();
+				if (mm_iterator_set_type* mmitset_ptr = (*this).mmitset_ptr()) { mmitset_ptr->reset(); }
+			}
+			void discard_journal() {
+				if (CUndoJournal* journal_ptr = (*this).journal_ptr()) { journal_ptr->discard_savepoints(); }
+			}
+			void sync_iterators_to_index() {
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+				m_instrumentation_counts.m_sync_iterators_to_index_calls += 1;
+				m_instrumentation_counts.m_reallocations += 1;
+				msevector_global_instrumentation::note_reallocation();
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+				note_buffer_change();
+				if (mm_iterator_set_type* mmitset_ptr = (*this).mmitset_ptr()) { mmitset_ptr->sync_iterators_to_index(); }
+			}
+			void invalidate_inclusive_range(mse::CSize_t start_index, mse::CSize_t end_index) {
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+				m_instrumentation_counts.m_invalidate_inclusive_range_calls += 1;
+				msevector_global_instrumentation::note_invalidate_inclusive_range_call();
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+				note_structural_change();
+				if (mm_iterator_set_type* mmitset_ptr = (*this).mmitset_ptr()) { mmitset_ptr->invalidate_inclusive_range(start_index, end_index); }
+			}
+			void shift_inclusive_range(mse::CSize_t start_index, mse::CSize_t end_index, mse::CInt shift) {
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+				m_instrumentation_counts.m_shift_inclusive_range_calls += 1;
+				msevector_global_instrumentation::note_shift_inclusive_range_call();
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+				note_structural_change();
+				if (mm_iterator_set_type* mmitset_ptr = (*this).mmitset_ptr()) { mmitset_ptr->shift_inclusive_range(start_index, end_index, shift); }
+			}
+			/* The fixups above advance the structure version themselves, the mutations that bypass them (like sort()) call
+			this directly. (Before the auxiliary state is allocated there are no weak_ipointers to invalidate.) */
+			void note_structural_change() {
+				if (CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr()) {
+					aux_state_ptr->m_structure_version += 1;
+					aux_state_ptr->m_buffer_generation += 1;
+				}
+			}
+			size_t structure_version() const {
+				CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr();
+				return (aux_state_ptr) ? aux_state_ptr->m_structure_version : 0;
+			}
+			void note_buffer_change() {
+				if (CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr()) { aux_state_ptr->m_buffer_generation += 1; }
+			}
+			/* (ss iterators hold the address of the buffer generation, so the auxiliary state is allocated when the first ss
+			iterator is obtained.) */
+			const size_t* buffer_generation_ptr() const {
+				CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr();
+				return (aux_state_ptr) ? &(aux_state_ptr->m_buffer_generation) : nullptr;
+			}
+
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+			msevector_instrumentation_counts m_instrumentation_counts;
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+		private:
+			CLazyAuxiliaryState(const CLazyAuxiliaryState& src_cref);
+			CLazyAuxiliaryState& operator=(const CLazyAuxiliaryState& _Right_cref);
+
+			CAuxiliaryState* aux_state_ptr() const { return m_aux_state_ptr.load(std::memory_order_acquire); }
+			mm_iterator_set_type* mmitset_ptr() const {
+				CAuxiliaryState* aux_state_ptr = (*this).aux_state_ptr();
+				return (aux_state_ptr) ? aux_state_ptr->m_mmitset_ptr.get() : nullptr;
+			}
+
+			std::atomic<CAuxiliaryState*> m_aux_state_ptr;
+		};
+		mutable CLazyAuxiliaryState m_aux_state;
+
+		void note_bounds_check_failure() const {
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+			m_aux_state.m_instrumentation_counts.m_bounds_check_failures += 1;
+			msevector_global_instrumentation::note_bounds_check_failure();
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+		}
+
+	public:
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+		/* The counts of the work done by this vector's safety machinery (see msevector_instrumentation_counts). */
+		const msevector_instrumentation_counts& instrumentation_counts() const { return m_aux_state.m_instrumentation_counts; }
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+
+	public:
+		mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) const {
+			return m_aux_state.mmitset().const_item_pointer(handle);
+		}
+		mm_iterator_type &item_pointer(mm_iterator_handle_type handle) {
+			return m_aux_state.mmitset().item_pointer(handle);
+		}
+
+	private:
+		mm_const_iterator_handle_type allocate_new_const_item_pointer(cipointer* handle_owner_ptr) const { return m_aux_state.allocated_mmitset(*this).allocate_new_const_item_pointer(handle_owner_ptr); }
+		void release_const_item_pointer(mm_const_iterator_handle_type handle) const { m_aux_state.mmitset().release_const_item_pointer(handle); }
+		void release_all_const_item_pointers() const { if (m_aux_state.has_mmitset()) { m_aux_state.mmitset().release_all_const_item_pointers(); } }
+		mm_iterator_handle_type allocate_new_item_pointer(ipointer* handle_owner_ptr) const { return m_aux_state.allocated_mmitset(*this).allocate_new_item_pointer(handle_owner_ptr); }
+		void release_item_pointer(mm_iterator_handle_type handle) const { m_aux_state.mmitset().release_item_pointer(handle); }
+		void release_all_item_pointers() const { if (m_aux_state.has_mmitset()) { m_aux_state.mmitset().release_all_item_pointers(); } }
+		size_t allocate_new_tracked_range(CSize_t begin_position, CSize_t end_position) {
+			if ((begin_position > end_position) || (CSize_t((*this).size()) < end_position)) {
+				note_bounds_check_failure();
+				throw(std::out_of_range("invalid range - size_t allocate_new_tracked_range() - msevector"));
+			}
+			return m_aux_state.allocated_mmitset(*this).allocate_tracked_range(mse::as_a_size_t(begin_position), mse::as_a_size_t(end_position));
+		}
+		void release_tracked_range(size_t range_index) { m_aux_state.mmitset().release_tracked_range(range_index); }
+		/* (Used when a cipointer or ipointer is moved, along with its registry slot.) */
+		void rebind_const_item_pointer_handle_owner(mm_const_iterator_handle_type handle, cipointer* handle_owner_ptr) const { const_item_pointer(handle).m_handle_owner_ptr = handle_owner_ptr; }
+		void rebind_item_pointer_handle_owner(mm_iterator_handle_type handle, ipointer* handle_owner_ptr) { item_pointer(handle).m_handle_owner_ptr = handle_owner_ptr; }
+		static mm_const_iterator_handle_type unregistered_const_item_pointer_handle() { return mm_const_iterator_handle_type(size_t(sc_unregistered_slot_index)); }
+		static mm_iterator_handle_type unregistered_item_pointer_handle() { return mm_iterator_handle_type(size_t(sc_unregistered_slot_index)); }
+		template<class _THandle>
+		static bool is_registered_handle(const _THandle& handle) { return (size_t(sc_unregistered_slot_index) != handle.m_key); }
+
+	public:
+		class cipointer {
+		public:
+			typedef typename mm_const_iterator_type::iterator_category iterator_category;
+			typedef typename mm_const_iterator_type::value_type value_type;
+			typedef typename mm_const_iterator_type::difference_type difference_type;
+			typedef difference_type distance_type;	// retained
+			typedef typename mm_const_iterator_type::pointer pointer;
+			typedef typename mm_const_iterator_type::const_pointer const_pointer;
+			typedef typename mm_const_iterator_type::reference reference;
+			typedef typename mm_const_iterator_type::const_reference const_reference;
+
+			cipointer(const _Myt& owner_cref) : m_owner_cptr(&owner_cref), m_handle(m_owner_cptr->allocate_new_const_item_pointer(this)) {}
+			cipointer(const cipointer& src_cref) : m_owner_cptr(src_cref.m_owner_cptr), m_handle(m_owner_cptr->allocate_new_const_item_pointer(this)) {
+				const_item_pointer() = src_cref.const_item_pointer();
+			}
+			/* Moves take over the source's registry slot (rather than allocating one). The moved-from cipointer is reregistered
+			(pointing to the beginning) if it's used again. */
+			cipointer(cipointer&& src) MSE_MSEVECTOR_MOVE_NOEXCEPT : m_owner_cptr(src.m_owner_cptr), m_handle(src.m_handle) {
+				src.m_handle = unregistered_const_item_pointer_handle();
+				if (is_registered_handle(m_handle)) { m_owner_cptr->rebind_const_item_pointer_handle_owner(m_handle, this); }
 			}
 			~cipointer() {
-				m_owner_cref.release_const_item_pointer(*m_handle_shptr);
+				if (is_registered_handle(m_handle)) { m_owner_cptr->release_const_item_pointer(m_handle); }
+			}
+			mm_const_iterator_type& const_item_pointer() const {
+				if (!is_registered_handle(m_handle)) { m_handle = m_owner_cptr->allocate_new_const_item_pointer(const_cast<cipointer*>(this)); }
+				return m_owner_cptr->const_item_pointer(m_handle);
 			}
-			mm_const_iterator_type& const_item_pointer() const { return m_owner_cref.const_item_pointer(*m_handle_shptr); }
 			mm_const_iterator_type& cip() const { return const_item_pointer(); }
-			//const mm_const_iterator_handle_type& handle() const { return (*m_handle_shptr); }
+			//const mm_const_iterator_handle_type& handle() const { return m_handle; }
 
 			void reset() { const_item_pointer().reset(); }
 			bool points_to_an_item() const { return const_item_pointer().points_to_an_item(); }
@@ -1236,8 +3012,9 @@ namespace mse {
 			void set_to_const_item_pointer(const cipointer& _Right_cref) { const_item_pointer().set_to_const_item_pointer(_Right_cref.const_item_pointer()); }
 			CSize_t position() const { return const_item_pointer().position(); }
 		private:
-			const _Myt& m_owner_cref;
-			std::shared_ptr<mm_const_iterator_handle_type> m_handle_shptr;
+			/* (A pointer rather than a reference, as splice() can move the cipointer to another vector.) */
+			const _Myt* m_owner_cptr;
+			mutable mm_const_iterator_handle_type m_handle;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
 		class ipointer {
@@ -1249,23 +3026,26 @@ namespace mse {
 			typedef typename mm_iterator_type::pointer pointer;
 			typedef typename mm_iterator_type::reference reference;
 
-			ipointer(_Myt& owner_ref) : m_owner_ref(owner_ref) {
-				mm_iterator_handle_type handle = m_owner_ref.allocate_new_item_pointer();
-				m_handle_shptr = std::shared_ptr<mm_iterator_handle_type>(new mm_iterator_handle_type(handle));
-			}
-			ipointer(const ipointer& src_cref) : m_owner_ref(src_cref.m_owner_ref) {
-				mm_iterator_handle_type handle = m_owner_ref.allocate_new_item_pointer();
-				m_handle_shptr = std::shared_ptr<mm_iterator_handle_type>(new mm_iterator_handle_type(handle));
+			ipointer(_Myt& owner_ref) : m_owner_ptr(&owner_ref), m_handle(m_owner_ptr->allocate_new_item_pointer(this)) {}
+			ipointer(const ipointer& src_cref) : m_owner_ptr(src_cref.m_owner_ptr), m_handle(m_owner_ptr->allocate_new_item_pointer(this)) {
 				item_pointer() = src_cref.item_pointer();
 			}
+			/* (As with cipointer, moves take over the source's registry slot.) */
+			ipointer(ipointer&& src) MSE_MSEVECTOR_MOVE_NOEXCEPT : m_owner_ptr(src.m_owner_ptr), m_handle(src.m_handle) {
+				src.m_handle = unregistered_item_pointer_handle();
+				if (is_registered_handle(m_handle)) { m_owner_ptr->rebind_item_pointer_handle_owner(m_handle, this); }
+			}
 			~ipointer() {
-				m_owner_ref.release_item_pointer(*m_handle_shptr);
+				if (is_registered_handle(m_handle)) { m_owner_ptr->release_item_pointer(m_handle); }
+			}
+			mm_iterator_type& item_pointer() const {
+				if (!is_registered_handle(m_handle)) { m_handle = m_owner_ptr->allocate_new_item_pointer(const_cast<ipointer*>(this)); }
+				return m_owner_ptr->item_pointer(m_handle);
 			}
-			mm_iterator_type& item_pointer() const { return m_owner_ref.item_pointer(*m_handle_shptr); }
 			mm_iterator_type& ip() const { return item_pointer(); }
-			//const mm_iterator_handle_type& handle() const { return (*m_handle_shptr); }
+			//const mm_iterator_handle_type& handle() const { return m_handle; }
 			operator cipointer() const {
-				cipointer retval(m_owner_ref);
+				cipointer retval(*m_owner_ptr);
 				retval.const_item_pointer().set_to_beginning();
 				retval.const_item_pointer().advance(mse::CInt(item_pointer().position()));
 				return retval;
@@ -1310,11 +3090,689 @@ namespace mse {
 			void set_to_item_pointer(const ipointer& _Right_cref) { item_pointer().set_to_item_pointer(_Right_cref.item_pointer()); }
 			CSize_t position() const { return item_pointer().position(); }
 		private:
-			_Myt& m_owner_ref;
-			std::shared_ptr<mm_iterator_handle_type> m_handle_shptr;
+			/* (A pointer rather than a reference, as splice() can move the ipointer to another vector.) */
+			_Myt* m_owner_ptr;
+			mutable mm_iterator_handle_type m_handle;
+			friend class /*_Myt*/msevector<_Ty, _A>;
+		};
+
+		/* A mutation_batch defers the fixups of (registered) ipointers for the mutations made during its lifespan and then
+		applies them in a single merged pass when it's committed (or destroyed). ipointers remain valid and usable during the
+		batch. Batches may be nested, in which case the fixups are applied when the outermost batch is committed. The batch
+		must not outlive the vector. */
+		class mutation_batch {
+		public:
+			mutation_batch(mutation_batch&& src) : m_owner_ptr(src.m_owner_ptr) { src.m_owner_ptr = nullptr; }
+			~mutation_batch() { commit(); }
+			void commit() {
+				if (nullptr != m_owner_ptr) {
+					m_owner_ptr->m_aux_state.mmitset().end_batch();
+					m_owner_ptr = nullptr;
+				}
+			}
+		private:
+			mutation_batch(_Myt& owner_ref) : m_owner_ptr(&owner_ref) { m_owner_ptr->m_aux_state.allocated_mmitset(owner_ref).begin_batch(); }
+			mutation_batch(const mutation_batch& src_cref);
+			mutation_batch& operator=(const mutation_batch& _Right_cref);
+			_Myt* m_owner_ptr;
+			friend class /*_Myt*/msevector<_Ty, _A>;
+		};
+		/* If the expected growth (in number of elements) is known, the required capacity is reserved up front. */
+		mutation_batch begin_batch(size_t expected_growth = 0) {
+			if (0 < expected_growth) { (*this).reserve((*this).size() + expected_growth); }
+			return mutation_batch(*this);
+		}
+
+		/* savepoint() marks the vector's current contents. rollback() undoes the (structural) mutations made since the
+		savepoint by replaying the inverse of each, newest first, through the normal insert()/erase() paths, so (registered)
+		ipointers are fixed up as they would be for any other insertion or removal rather than being reset. While any savepoint
+		is outstanding, each insertion journals just its position and count, and each removal journals the removed elements, so
+		the cost of a rollback is proportional to the changes made, not to the size of the vector. Reorderings (like sort())
+		journal their permutation, and rolling them back moves the elements (and their ipointers) back to where they were.
+		Modifications made to elements directly (through references or iterators) are not journaled. Savepoints nest; rolling
+		back to (or releasing) a savepoint discards any savepoints taken after it. A rolled back savepoint remains valid until
+		it is released. */
+		class savepoint_type {
+		public:
+			savepoint_type(const savepoint_type& src_cref) : m_level(src_cref.m_level), m_serial_number(src_cref.m_serial_number) {}
+		private:
+			savepoint_type(size_t level, size_t serial_number) : m_level(level), m_serial_number(serial_number) {}
+			size_t m_level;
+			size_t m_serial_number;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
+		savepoint_type savepoint() {
+			static_assert(_mse_msevector_journals_removals<_Ty>::value, "savepoints require a copy constructible element type - savepoint_type savepoint() - msevector");
+			CAuxiliaryState& aux_state_ref = m_aux_state.allocated();
+			if (!aux_state_ref.m_journal_ptr) {
+				aux_state_ref.m_journal_ptr.reset(new CUndoJournal());
+			}
+			CUndoJournal& journal_ref = (*aux_state_ref.m_journal_ptr);
+			typename CUndoJournal::CSavepointRecord record;
+			record.m_number_of_entries = journal_ref.m_entries.size();
+			record.m_serial_number = journal_ref.m_next_serial_number;
+			journal_ref.m_next_serial_number += 1;
+			journal_ref.m_savepoints.push_back(record);
+			return savepoint_type(journal_ref.m_savepoints.size() - 1, record.m_serial_number);
+		}
+		void rollback(const savepoint_type& sp) {
+			CUndoJournal& journal_ref = journal_for(sp, "invalid savepoint - void rollback() - msevector");
+			bool was_suspended = journal_ref.m_suspended;
+			journal_ref.m_suspended = true;
+			try {
+				size_t number_of_entries_to_keep = journal_ref.m_savepoints[sp.m_level].m_number_of_entries;
+				while (number_of_entries_to_keep < journal_ref.m_entries.size()) {
+					typename CUndoJournal::CEntry entry = journal_ref.m_entries.back();
+					auto position_iter = base_class::begin();
+					std::advance(position_iter, entry.m_position);
+					if (entry.m_is_removal) {
+						auto values_iter = journal_ref.m_removed_values.begin();
+						std::advance(values_iter, entry.m_values_offset);
+						insert(position_iter, std::make_move_iterator(values_iter), std::make_move_iterator(journal_ref.m_removed_values.end()));
+						journal_ref.m_removed_values.erase(values_iter, journal_ref.m_removed_values.end());
+					}
+					else if (entry.m_is_permutation) {
+						/* The journaled new positions of the elements are the old positions of the inverse permutation. */
+						std::vector<size_t> old_positions(journal_ref.m_permutation_positions.begin() + entry.m_values_offset, journal_ref.m_permutation_positions.end());
+						journal_ref.m_permutation_positions.resize(entry.m_values_offset);
+						permute_elements(old_positions);
+					}
+					else if (entry.m_is_rotation) {
+						/* rotates the (lower) block that was rotated to the end of the range back to the beginning */
+						rotate_range_to(entry.m_position + entry.m_count, entry.m_position, entry.m_position + entry.m_count - entry.m_values_offset);
+					}
+					else {
+						auto last_iter = position_iter;
+						std::advance(last_iter, entry.m_count);
+						erase(position_iter, last_iter);
+					}
+					journal_ref.m_entries.pop_back();
+				}
+			}
+			catch (...) {
+				journal_ref.m_suspended = was_suspended;
+				throw;
+			}
+			journal_ref.m_suspended = was_suspended;
+			journal_ref.m_savepoints.resize(sp.m_level + 1);
+		}
+		void release(const savepoint_type& sp) {
+			CUndoJournal& journal_ref = journal_for(sp, "invalid savepoint - void release() - msevector");
+			journal_ref.m_savepoints.resize(sp.m_level);
+			if (journal_ref.m_savepoints.empty()) { journal_ref.discard_entries(); }
+		}
+		size_t number_of_savepoints() const {
+			const CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			return (journal_ptr) ? journal_ptr->m_savepoints.size() : 0;
+		}
+
+	private:
+		class CUndoJournal {
+		public:
+			CUndoJournal() : m_next_serial_number(1), m_suspended(false) {}
+			bool is_recording() const { return ((!m_suspended) && (!m_savepoints.empty())); }
+			void discard_entries() {
+				m_entries.clear();
+				m_removed_values.clear();
+				m_permutation_positions.clear();
+			}
+			/* The serial numbers aren't reused, so the discarded savepoints can't be mistaken for later ones. */
+			void discard_savepoints() {
+				m_savepoints.clear();
+				discard_entries();
+			}
+
+			class CEntry {
+			public:
+				size_t m_position;
+				size_t m_count;
+				/* For removals, the removed elements are stored in m_removed_values starting at this offset. For permutations, the
+				new positions of the (m_count) elements are stored in m_permutation_positions starting at this offset. For
+				rotations, this is the length of the (lower) block that was rotated to the end of the range. */
+				size_t m_values_offset;
+				bool m_is_removal;
+				bool m_is_permutation;
+				bool m_is_rotation;
+				bool is_insertion() const { return ((!m_is_removal) && (!m_is_permutation) && (!m_is_rotation)); }
+			};
+			class CSavepointRecord {
+			public:
+				size_t m_number_of_entries;
+				size_t m_serial_number;
+			};
+			std::vector<CEntry> m_entries;
+			std::vector<_Ty> m_removed_values;
+			std::vector<size_t> m_permutation_positions;
+			std::vector<CSavepointRecord> m_savepoints;
+			size_t m_next_serial_number;
+			bool m_suspended;
+		};
+		CUndoJournal& journal_for(const savepoint_type& sp, const char* error_message) {
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if ((!journal_ptr) || (journal_ptr->m_savepoints.size() <= sp.m_level)
+				|| (journal_ptr->m_savepoints[sp.m_level].m_serial_number != sp.m_serial_number)) {
+				throw(std::out_of_range(error_message));
+			}
+			return (*journal_ptr);
+		}
+		void journal_insertion(CSize_t position, CSize_t count) {
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if ((!journal_ptr) || (!journal_ptr->is_recording()) || (0 == count)) { return; }
+			CUndoJournal& journal_ref = (*journal_ptr);
+			size_t position_st = mse::as_a_size_t(position);
+			size_t count_st = mse::as_a_size_t(count);
+			if ((!journal_ref.m_entries.empty()) && (journal_ref.m_savepoints.back().m_number_of_entries < journal_ref.m_entries.size())) {
+				/* Consecutive insertions that extend the previous one (like a run of push_back()s) share an entry. */
+				typename CUndoJournal::CEntry& last_entry_ref = journal_ref.m_entries.back();
+				if ((last_entry_ref.is_insertion()) && (last_entry_ref.m_position + last_entry_ref.m_count == position_st)) {
+					last_entry_ref.m_count += count_st;
+					return;
+				}
+			}
+			typename CUndoJournal::CEntry entry;
+			entry.m_position = position_st;
+			entry.m_count = count_st;
+			entry.m_values_offset = 0;
+			entry.m_is_removal = false;
+			entry.m_is_permutation = false;
+			entry.m_is_rotation = false;
+			journal_ref.m_entries.push_back(entry);
+		}
+		void journal_erasure(CSize_t position, CSize_t count) {
+			journal_erasure(position, count, _mse_msevector_journals_removals<_Ty>());
+		}
+		/* There can't be any savepoints (see savepoint()), so there's nothing to journal. */
+		void journal_erasure(CSize_t /*position*/, CSize_t /*count*/, std::false_type) {}
+		void journal_erasure(CSize_t position, CSize_t count, std::true_type) {
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if ((!journal_ptr) || (!journal_ptr->is_recording()) || (0 == count)) { return; }
+			CUndoJournal& journal_ref = (*journal_ptr);
+			size_t position_st = mse::as_a_size_t(position);
+			size_t count_st = mse::as_a_size_t(count);
+			typename CUndoJournal::CEntry entry;
+			entry.m_position = position_st;
+			entry.m_count = count_st;
+			entry.m_values_offset = journal_ref.m_removed_values.size();
+			entry.m_is_removal = true;
+			entry.m_is_permutation = false;
+			entry.m_is_rotation = false;
+			auto first_iter = base_class::begin();
+			std::advance(first_iter, position_st);
+			auto last_iter = first_iter;
+			std::advance(last_iter, count_st);
+			journal_ref.m_removed_values.insert(journal_ref.m_removed_values.end(), first_iter, last_iter);
+			journal_ref.m_entries.push_back(entry);
+		}
+
+		/* new_positions[i] is the position the element at position i was moved to. */
+		void journal_permutation(const std::vector<size_t>& new_positions) {
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if ((!journal_ptr) || (!journal_ptr->is_recording()) || (new_positions.empty())) { return; }
+			CUndoJournal& journal_ref = (*journal_ptr);
+			typename CUndoJournal::CEntry entry;
+			entry.m_position = 0;
+			entry.m_count = new_positions.size();
+			entry.m_values_offset = journal_ref.m_permutation_positions.size();
+			entry.m_is_removal = false;
+			entry.m_is_permutation = true;
+			entry.m_is_rotation = false;
+			journal_ref.m_permutation_positions.insert(journal_ref.m_permutation_positions.end(), new_positions.begin(), new_positions.end());
+			journal_ref.m_entries.push_back(entry);
+		}
+		/* The block [upper_first, upper_last) was rotated to lower_first. */
+		void journal_rotation(size_t lower_first, size_t upper_first, size_t upper_last) {
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if ((!journal_ptr) || (!journal_ptr->is_recording())) { return; }
+			typename CUndoJournal::CEntry entry;
+			entry.m_position = lower_first;
+			entry.m_count = upper_last - lower_first;
+			entry.m_values_offset = upper_first - lower_first;
+			entry.m_is_removal = false;
+			entry.m_is_permutation = false;
+			entry.m_is_rotation = true;
+			journal_ptr->m_entries.push_back(entry);
+		}
+		bool is_journaling() const {
+			const CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			return ((journal_ptr) && (journal_ptr->is_recording()));
+		}
+		/* Discards the savepoints after an operation fails in a way that can't be rolled back. */
+		void discard_savepoints() {
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if (journal_ptr) { journal_ptr->discard_savepoints(); }
+		}
+
+		template<class _TIter>
+		void reserve_for_append(const _TIter& first, const _TIter& last, size_t /*size_hint*/, std::forward_iterator_tag) {
+			reserve_for_growth(size_t(std::distance(first, last)));
+		}
+		template<class _TIter>
+		void reserve_for_append(const _TIter& /*first*/, const _TIter& /*last*/, size_t size_hint, std::input_iterator_tag) {
+			if (0 < size_hint) { reserve_for_growth(size_hint); }
+		}
+		/* Makes room for count more elements. Like push_back(), the capacity is grown geometrically (rather than to just what's
+		required), so that a sequence of small appends doesn't reallocate on each one. */
+		void reserve_for_growth(size_t count) {
+			const size_t required_capacity = (*this).size() + count;
+			if ((*this).capacity() >= required_capacity) { return; }
+			size_t new_capacity = 2 * (*this).capacity();
+			if ((new_capacity < required_capacity) || (base_class::max_size() < new_capacity)) { new_capacity = required_capacity; }
+			base_class::reserve(new_capacity);
+		}
+		void append_default_init(size_t count) {
+			const size_t original_size = (*this).size();
+			const size_t original_capacity = (*this).capacity();
+			base_class::resize(original_size + count);
+			complete_append(original_size, original_capacity);
+		}
+		/* Does the bookkeeping for elements appended directly to the base vector (in one go). */
+		void complete_append(size_t original_size, size_t original_capacity) {
+			update_debug_size();
+			const size_t number_appended = (*this).size() - original_size;
+			if (0 < number_appended) {
+				journal_insertion(original_size, number_appended);
+				m_aux_state.shift_inclusive_range(original_size, original_size, CInt(number_appended)); /*shift the end markers*/
+			}
+			if ((*this).capacity() != original_capacity) {
+				m_aux_state.sync_iterators_to_index();
+			}
+		}
+
+		/* The following do the element movement for insertions and erasures. For element types that can be relocated bitwise
+		(see msevector_is_trivially_relocatable), new elements are constructed at the end and then relocated into place (and
+		erasures close the gap) with memmove() rather than with element by element moves. (The base vector can't make room in
+		the middle without constructing elements there, hence the construction at the end.) */
+		static const size_t sc_relocation_buffer_size = 512;
+		unsigned char* element_bytes(size_t position) { return (reinterpret_cast<unsigned char*>(base_class::data()) + position * sizeof(_Ty)); }
+		/* Moves the last count elements to the given position, shifting the elements from that position on up. This swaps two
+		adjacent blocks of elements, so the smaller block is set aside in a (fixed size) buffer on the stack while the other
+		is memmove()d. If neither block fits in the buffer, the blocks are just rotated element by element. */
+		void relocate_tail_to(size_t position, size_t count) {
+			const size_t tail_position = (*this).size() - count;
+			if ((0 == count) || (tail_position == position)) { return; }
+			const size_t number_of_upper_bytes = count * sizeof(_Ty);
+			const size_t number_of_lower_bytes = (tail_position - position) * sizeof(_Ty);
+			unsigned char buffer[sc_relocation_buffer_size];
+			if (sc_relocation_buffer_size >= number_of_upper_bytes) {
+				std::memcpy(buffer, element_bytes(tail_position), number_of_upper_bytes);
+				std::memmove(element_bytes(position + count), element_bytes(position), number_of_lower_bytes);
+				std::memcpy(element_bytes(position), buffer, number_of_upper_bytes);
+			}
+			else if (sc_relocation_buffer_size >= number_of_lower_bytes) {
+				std::memcpy(buffer, element_bytes(position), number_of_lower_bytes);
+				std::memmove(element_bytes(position), element_bytes(tail_position), number_of_upper_bytes);
+				std::memcpy(element_bytes(position + count), buffer, number_of_lower_bytes);
+			}
+			else {
+				std::rotate(base_class::begin() + position, base_class::begin() + tail_position, base_class::end());
+			}
+		}
+		void base_insert_n(size_t position, size_t count, const _Ty& value, std::false_type) {
+			base_class::insert(base_class::begin() + position, count, value);
+		}
+		void base_insert_n(size_t position, size_t count, const _Ty& value, std::true_type) {
+			base_class::insert(base_class::end(), count, value);
+			relocate_tail_to(position, count);
+		}
+		template<class _Iter>
+		void base_insert_range(size_t position, _Iter first, _Iter last, std::false_type) {
+			base_class::insert(base_class::begin() + position, first, last);
+		}
+		template<class _Iter>
+		void base_insert_range(size_t position, _Iter first, _Iter last, std::true_type) {
+			const size_t original_size = (*this).size();
+			base_class::insert(base_class::end(), first, last);
+			const size_t count = (*this).size() - original_size;
+			try {
+				relocate_tail_to(position, count);
+			}
+			catch (...) {
+				base_class::erase(base_class::begin() + original_size, base_class::end());
+				throw;
+			}
+		}
+		template<class
+#ifndef MSVC2010_COMPATIBILE
+			...
+#endif /*MSVC2010_COMPATIBILE*/
+			_Valty>
+		void base_emplace(size_t position, std::false_type, _Valty&&
+#ifndef MSVC2010_COMPATIBILE
+			...
+#endif /*MSVC2010_COMPATIBILE*/
+			_Val) {
+			base_class::emplace(base_class::begin() + position, std::forward<_Valty>(_Val)
+#ifndef MSVC2010_COMPATIBILE
+				...
+#endif /*MSVC2010_COMPATIBILE*/
+				);
+		}
+		template<class
+#ifndef MSVC2010_COMPATIBILE
+			...
+#endif /*MSVC2010_COMPATIBILE*/
+			_Valty>
+		void base_emplace(size_t position, std::true_type, _Valty&&
+#ifndef MSVC2010_COMPATIBILE
+			...
+#endif /*MSVC2010_COMPATIBILE*/
+			_Val) {
+			base_class::emplace_back(std::forward<_Valty>(_Val)
+#ifndef MSVC2010_COMPATIBILE
+				...
+#endif /*MSVC2010_COMPATIBILE*/
+				);
+			relocate_tail_to(position, 1);
+		}
+		void base_erase(size_t first, size_t last, std::false_type) {
+			base_class::erase(base_class::begin() + first, base_class::begin() + last);
+		}
+		void base_erase(size_t first, size_t last, std::true_type) {
+			if (first == last) { return; }
+			/* (The erased elements are trivially destructible, so they can just be overwritten.) */
+			std::memmove(element_bytes(first), element_bytes(last), ((*this).size() - last) * sizeof(_Ty));
+			base_class::erase(base_class::end() - (last - first), base_class::end());
+		}
+
+		/* Journals the removal of a single element. Consecutive removals at the same position share an entry. (Non-copyable
+		elements can't have savepoints, so are never journaled.) */
+		void journal_removed_element(CUndoJournal& /*journal_ref*/, size_t /*position*/, const _Ty& /*value*/, std::false_type) {}
+		void journal_removed_element(CUndoJournal& journal_ref, size_t position, const _Ty& value, std::true_type) {
+			if ((!journal_ref.m_entries.empty()) && (journal_ref.m_savepoints.back().m_number_of_entries < journal_ref.m_entries.size())) {
+				typename CUndoJournal::CEntry& last_entry_ref = journal_ref.m_entries.back();
+				if (last_entry_ref.m_is_removal && (last_entry_ref.m_position == position)) {
+					journal_ref.m_removed_values.push_back(value);
+					last_entry_ref.m_count += 1;
+					return;
+				}
+			}
+			typename CUndoJournal::CEntry entry;
+			entry.m_position = position;
+			entry.m_count = 1;
+			entry.m_values_offset = journal_ref.m_removed_values.size();
+			entry.m_is_removal = true;
+			entry.m_is_permutation = false;
+			entry.m_is_rotation = false;
+			journal_ref.m_removed_values.push_back(value);
+			journal_ref.m_entries.push_back(entry);
+		}
+
+		typedef typename mm_iterator_set_type::CBatchMapPiece CPositionMapPiece;
+		/* Keeps track of the compaction done by erase_if(). The position map (used to fix up the ipointers) and the undo
+		journal are only maintained when needed. */
+		class CEraseIfCompaction {
+		public:
+			CEraseIfCompaction(_Myt& owner_ref, size_t first_index, bool maintain_position_map, CUndoJournal* journal_ptr)
+				: m_owner_ref(owner_ref), m_write_index(first_index), m_number_removed(0), m_maintain_position_map(maintain_position_map)
+				, m_journal_ptr(journal_ptr) {
+				if ((m_maintain_position_map) && (0 < first_index)) { append_piece(0, first_index - 1, 0, false); }
+			}
+			void keep(size_t read_index) {
+				if (m_write_index != read_index) {
+					m_owner_ref.base_class::operator[](m_write_index) = std::move(m_owner_ref.base_class::operator[](read_index));
+				}
+				if (m_maintain_position_map) { append_piece(read_index, read_index, size_t(0) - m_number_removed, false); }
+				m_write_index += 1;
+			}
+			void remove(size_t read_index) {
+				if (m_journal_ptr) {
+					/* Expressed as a sequence of single element removals, the element would be removed from position m_write_index. */
+					m_owner_ref.journal_removed_element(*m_journal_ptr, m_write_index, m_owner_ref.base_class::operator[](read_index), _mse_msevector_journals_removals<_Ty>());
+				}
+				if (m_maintain_position_map) { append_piece(read_index, read_index, 0, true); }
+				m_number_removed += 1;
+			}
+			/* Erases the vacated tail and fixes up the ipointers. */
+			void complete(size_t end_index) {
+				if (0 == m_number_removed) { return; }
+				m_owner_ref.m_aux_state.note_structural_change();
+				const size_t original_size = m_owner_ref.size();
+				const size_t original_capacity = m_owner_ref.capacity();
+				auto first_iter = m_owner_ref.base_class::begin();
+				std::advance(first_iter, m_write_index + (original_size - end_index));
+				if (end_index != original_size) {
+					/* move the elements after the range down */
+					auto end_iter = m_owner_ref.base_class::begin();
+					std::advance(end_iter, end_index);
+					auto write_iter = m_owner_ref.base_class::begin();
+					std::advance(write_iter, m_write_index);
+					std::move(end_iter, m_owner_ref.base_class::end(), write_iter);
+				}
+				if (m_maintain_position_map) {
+					/* (The ipointers are fixed up before the tail is erased, while their old positions are still in range.) */
+					append_piece(end_index, mm_iterator_set_type::sc_max_position, size_t(0) - m_number_removed, false);
+					m_owner_ref.m_aux_state.mmitset().apply_piecewise_map(m_position_map);
+				}
+				m_owner_ref.base_class::erase(first_iter, m_owner_ref.base_class::end());
+				m_owner_ref.update_debug_size();
+				if (m_owner_ref.capacity() != original_capacity) {
+					m_owner_ref.m_aux_state.sync_iterators_to_index();
+				}
+			}
+			size_t number_removed() const { return m_number_removed; }
+		private:
+			void append_piece(size_t first, size_t last, size_t shift, bool invalidated) {
+				CPositionMapPiece piece;
+				piece.m_first = first;
+				piece.m_last = last;
+				piece.m_shift = shift;
+				piece.m_invalidated = invalidated;
+				mm_iterator_set_type::append_map_piece(m_position_map, piece);
+			}
+
+			_Myt& m_owner_ref;
+			size_t m_write_index;
+			size_t m_number_removed;
+			bool m_maintain_position_map;
+			std::vector<CPositionMapPiece> m_position_map;
+			CUndoJournal* m_journal_ptr;
+		};
+		template<class _TPredicate>
+		size_t erase_if_in_range(size_t first_index, size_t end_index, _TPredicate& pred) {
+			if ((first_index > end_index) || ((*this).size() < end_index)) { throw(std::out_of_range("invalid range - size_t erase_if() - msevector")); }
+			CUndoJournal* journal_ptr = m_aux_state.journal_ptr();
+			if ((journal_ptr) && (!journal_ptr->is_recording())) { journal_ptr = nullptr; }
+			bool maintain_position_map = has_position_tracking_dependents();
+			CEraseIfCompaction compaction(*this, first_index, maintain_position_map, journal_ptr);
+			size_t read_index = first_index;
+			try {
+				for (; end_index > read_index; read_index += 1) {
+					if (pred(base_class::operator[](read_index))) {
+						compaction.remove(read_index);
+					}
+					else {
+						compaction.keep(read_index);
+					}
+				}
+			}
+			catch (...) {
+				for (; end_index > read_index; read_index += 1) {
+					compaction.keep(read_index);
+				}
+				compaction.complete(end_index);
+				throw;
+			}
+			compaction.complete(end_index);
+			return compaction.number_removed();
+		}
 
+		bool has_registered_ipointers() const { return (m_aux_state.has_mmitset() && (!m_aux_state.mmitset().empty())); }
+		/* Whether reorderings need to keep track of the elements' original positions. */
+		bool tracks_reorderings() const { return (has_registered_ipointers() || is_journaling()); }
+		/* (Permutations leave the iranges alone, but the other position maps also need to be applied to them.) */
+		bool has_position_tracking_dependents() const {
+			return (m_aux_state.has_mmitset() && ((!m_aux_state.mmitset().empty()) || m_aux_state.mmitset().has_tracked_ranges()));
+		}
+		typedef std::pair<_Ty, size_t> CElementAndPosition;
+		/* Orders (element, original position) pairs by their elements. */
+		template<class _TCompare>
+		class CElementAndPositionCompare {
+		public:
+			CElementAndPositionCompare(_TCompare comp) : m_comp(comp) {}
+			bool operator()(const CElementAndPosition& lhs, const CElementAndPosition& rhs) { return m_comp(lhs.first, rhs.first); }
+		private:
+			_TCompare m_comp;
+		};
+		static const int sc_reorder_sort = 0;
+		static const int sc_reorder_stable_sort = 1;
+		static const int sc_reorder_nth_element = 2;
+		/* The elements are moved out (with their positions) and reordered there rather than reordering an array of positions
+		with an indirect comparison, as the latter has much worse locality. */
+		template<class _TCompare>
+		void reorder_tracking_positions(int reorder_kind, size_t nth, _TCompare comp) {
+			const size_t number_of_elements = (*this).size();
+			std::vector<CElementAndPosition> elements_and_positions;
+			elements_and_positions.reserve(number_of_elements);
+			std::vector<size_t> new_positions(number_of_elements);
+			try {
+				for (size_t i = 0; number_of_elements > i; i += 1) {
+					elements_and_positions.push_back(CElementAndPosition(std::move(base_class::operator[](i)), i));
+				}
+				CElementAndPositionCompare<_TCompare> element_compare(comp);
+				if (sc_reorder_stable_sort == reorder_kind) {
+					std::stable_sort(elements_and_positions.begin(), elements_and_positions.end(), element_compare);
+				}
+				else if (sc_reorder_nth_element == reorder_kind) {
+					std::nth_element(elements_and_positions.begin(), elements_and_positions.begin() + nth, elements_and_positions.end(), element_compare);
+				}
+				else {
+					std::sort(elements_and_positions.begin(), elements_and_positions.end(), element_compare);
+				}
+			}
+			catch (...) {
+				/* the moved out elements are a permutation of (a prefix of) the originals */
+				for (size_t i = 0; elements_and_positions.size() > i; i += 1) {
+					base_class::operator[](i) = std::move(elements_and_positions[i].first);
+				}
+				m_aux_state.reset();
+				discard_savepoints();
+				throw;
+			}
+			try {
+				for (size_t i = 0; number_of_elements > i; i += 1) {
+					base_class::operator[](i) = std::move(elements_and_positions[i].first);
+					new_positions[elements_and_positions[i].second] = i;
+				}
+			}
+			catch (...) {
+				m_aux_state.reset();
+				discard_savepoints();
+				throw;
+			}
+			if (has_registered_ipointers()) {
+				m_aux_state.mmitset().apply_permutation_map(new_positions);
+			}
+			journal_permutation(new_positions);
+		}
+		/* Moves the element at old_positions[i] to position i (following each cycle of the permutation with one temporary), then
+		remaps the ipointers. old_positions is assumed to be a valid permutation. */
+		void permute_elements(const std::vector<size_t>& old_positions) {
+			m_aux_state.note_structural_change();
+			const size_t number_of_elements = old_positions.size();
+			std::vector<size_t> new_positions(number_of_elements);
+			try {
+				std::vector<bool> placed(number_of_elements, false);
+				for (size_t start = 0; number_of_elements > start; start += 1) {
+					new_positions[old_positions[start]] = start;
+					if ((placed[start]) || (old_positions[start] == start)) { continue; }
+					_Ty temp(std::move(base_class::operator[](start)));
+					size_t destination = start;
+					while (true) {
+						placed[destination] = true;
+						const size_t source = old_positions[destination];
+						if (start == source) {
+							base_class::operator[](destination) = std::move(temp);
+							break;
+						}
+						base_class::operator[](destination) = std::move(base_class::operator[](source));
+						destination = source;
+					}
+				}
+			}
+			catch (...) {
+				m_aux_state.reset();
+				discard_savepoints();
+				throw;
+			}
+			if (has_registered_ipointers()) {
+				m_aux_state.mmitset().apply_permutation_map(new_positions);
+			}
+			journal_permutation(new_positions);
+		}
+		void rotate_range_to(size_t dest_position, size_t first_position, size_t last_position) {
+			if ((first_position == last_position) || (first_position == dest_position) || (last_position == dest_position)) { return; }
+			if ((first_position < dest_position) && (last_position > dest_position)) {
+				throw(std::out_of_range("invalid argument - void splice() - msevector"));
+			}
+			/* the two adjacent ranges that swap places */
+			size_t lower_first = dest_position;
+			size_t upper_first = first_position;
+			size_t upper_last = last_position;
+			if (dest_position > last_position) {
+				lower_first = first_position;
+				upper_first = last_position;
+				upper_last = dest_position;
+			}
+			std::rotate(base_class::begin() + lower_first, base_class::begin() + upper_first, base_class::begin() + upper_last);
+			m_aux_state.note_structural_change();
+			journal_rotation(lower_first, upper_first, upper_last);
+			if (has_position_tracking_dependents()) {
+				std::vector<CPositionMapPiece> position_map;
+				CPositionMapPiece piece;
+				piece.m_invalidated = false;
+				piece.m_first = 0;
+				piece.m_shift = 0;
+				if (0 < lower_first) {
+					piece.m_last = lower_first - 1;
+					mm_iterator_set_type::append_map_piece(position_map, piece);
+				}
+				piece.m_first = lower_first;
+				piece.m_last = upper_first - 1;
+				piece.m_shift = upper_last - upper_first;
+				mm_iterator_set_type::append_map_piece(position_map, piece);
+				piece.m_first = upper_first;
+				piece.m_last = upper_last - 1;
+				piece.m_shift = size_t(0) - (upper_first - lower_first);
+				mm_iterator_set_type::append_map_piece(position_map, piece);
+				piece.m_first = upper_last;
+				piece.m_last = mm_iterator_set_type::sc_max_position;
+				piece.m_shift = 0;
+				mm_iterator_set_type::append_map_piece(position_map, piece);
+				m_aux_state.mmitset().apply_piecewise_map(position_map);
+			}
+		}
+		void splice_insert(size_t dest_position, _Myt& src, size_t first_position, size_t last_position, std::true_type) {
+			if (src.is_journaling()) {
+				(*this).insert(base_class::begin() + dest_position, src.base_class::begin() + first_position, src.base_class::begin() + last_position);
+			}
+			else {
+				splice_insert(dest_position, src, first_position, last_position, std::false_type());
+			}
+		}
+		void splice_insert(size_t dest_position, _Myt& src, size_t first_position, size_t last_position, std::false_type) {
+			(*this).insert(base_class::begin() + dest_position, std::make_move_iterator(src.base_class::begin() + first_position)
+				, std::make_move_iterator(src.base_class::begin() + last_position));
+		}
+		void adopt_cipointer(cipointer& cipointer_ref, size_t position) {
+			mm_const_iterator_handle_type handle = allocate_new_const_item_pointer(&cipointer_ref);
+			cipointer_ref.m_owner_cptr->release_const_item_pointer(cipointer_ref.m_handle);
+			cipointer_ref.m_owner_cptr = this;
+			cipointer_ref.m_handle = handle;
+			mm_const_iterator_type& item_ref = const_item_pointer(handle);
+			item_ref.set_to_beginning();
+			item_ref.advance(mse::CInt(mse::CSize_t(position)));
+		}
+		void adopt_ipointer(ipointer& ipointer_ref, size_t position) {
+			mm_iterator_handle_type handle = allocate_new_item_pointer(&ipointer_ref);
+			ipointer_ref.m_owner_ptr->release_item_pointer(ipointer_ref.m_handle);
+			ipointer_ref.m_owner_ptr = this;
+			ipointer_ref.m_handle = handle;
+			mm_iterator_type& item_ref = item_pointer(handle);
+			item_ref.set_to_beginning();
+			item_ref.advance(mse::CInt(mse::CSize_t(position)));
+		}
+
+	public:
 		ipointer ibegin() {	// return ipointer for beginning of mutable sequence
 			ipointer retval(*this);
 			retval.set_to_beginning();
@@ -1347,8 +3805,8 @@ namespace mse {
 		}
 
 		msevector(const cipointer &start, const cipointer &end, const _A& _Al = _A())
-			: base_class(static_cast<typename base_class::const_iterator>(start.const_item_pointer()), static_cast<typename base_class::const_iterator>(end.const_item_pointer()), _Al), m_mmitset(*this) {
-			m_debug_size = size();
+			: base_class(static_cast<typename base_class::const_iterator>(start.const_item_pointer()), static_cast<typename base_class::const_iterator>(end.const_item_pointer()), _Al) {
+			update_debug_size();
 		}
 		void assign(const mm_const_iterator_type &start, const mm_const_iterator_type &end) {
 			if (start.m_owner_cref != end.m_owner_cref) { throw(std::out_of_range("invalid arguments - void assign(const mm_const_iterator_type &start, const mm_const_iterator_type &end) - msevector")); }
@@ -1455,6 +3913,90 @@ namespace mse {
 			(*this).insert(_P, _Ilist);
 		}
 #endif /*MSVC2010_COMPATIBILE*/
+		/* Inserts each value before the element at the corresponding (original) position. The range is of (position, value)
+		pairs sorted by position. (Values with equal positions are inserted in the order given.) The storage is grown at most
+		once, each existing element is moved at most once, and the ipointers are fixed up in a single pass. If an element
+		assignment throws, the vector is left valid but its contents are unspecified and its ipointers are reset. */
+		template<class _TBidirIter>
+		void insert_before_positions(_TBidirIter first, _TBidirIter last) {
+			const size_t original_size = (*this).size();
+			const size_t original_capacity = (*this).capacity();
+			size_t number_of_insertions = 0;
+			{
+				size_t previous_position = 0;
+				for (_TBidirIter iter = first; last != iter; ++iter) {
+					const size_t position = mse::as_a_size_t(CSize_t((*iter).first));
+					if ((previous_position > position) || (original_size < position)) { throw(std::out_of_range("invalid argument - void insert_before_positions() - msevector")); }
+					previous_position = position;
+					number_of_insertions += 1;
+				}
+			}
+			if (0 == number_of_insertions) { return; }
+
+			/* The vector is grown (once) by appending copies of the first value, which are then overwritten. */
+			base_class::insert(base_class::end(), number_of_insertions, (*first).second);
+			update_debug_size();
+			m_aux_state.note_structural_change();
+			if ((*this).capacity() != original_capacity) {
+				m_aux_state.sync_iterators_to_index();
+			}
+			try {
+				/* From the back, each segment of existing elements is moved up (once) to its final position, followed by the
+				value to be inserted before it. */
+				size_t read_index = original_size;
+				size_t write_index = original_size + number_of_insertions;
+				_TBidirIter iter = last;
+				while (first != iter) {
+					--iter;
+					const size_t position = mse::as_a_size_t(CSize_t((*iter).first));
+					auto segment_first = base_class::begin();
+					std::advance(segment_first, position);
+					auto segment_last = base_class::begin();
+					std::advance(segment_last, read_index);
+					auto segment_destination_last = base_class::begin();
+					std::advance(segment_destination_last, write_index);
+					std::move_backward(segment_first, segment_last, segment_destination_last);
+					write_index -= (read_index - position);
+					read_index = position;
+					write_index -= 1;
+					base_class::operator[](write_index) = (*iter).second;
+				}
+			}
+			catch (...) {
+				m_aux_state.reset();
+				throw;
+			}
+
+			size_t number_inserted_so_far = 0;
+			for (_TBidirIter iter = first; last != iter; ++iter) {
+				journal_insertion(CSize_t(mse::as_a_size_t(CSize_t((*iter).first)) + number_inserted_so_far), 1);
+				number_inserted_so_far += 1;
+			}
+			if (has_position_tracking_dependents()) {
+				/* Each existing element is shifted by the number of values inserted at or before its position. */
+				std::vector<CPositionMapPiece> position_map;
+				CPositionMapPiece piece;
+				piece.m_first = 0;
+				piece.m_shift = 0;
+				piece.m_invalidated = false;
+				for (_TBidirIter iter = first; last != iter; ++iter) {
+					const size_t position = mse::as_a_size_t(CSize_t((*iter).first));
+					if (piece.m_first < position) {
+						piece.m_last = position - 1;
+						mm_iterator_set_type::append_map_piece(position_map, piece);
+						piece.m_first = position;
+					}
+					piece.m_shift += 1;
+				}
+				piece.m_last = mm_iterator_set_type::sc_max_position;
+				mm_iterator_set_type::append_map_piece(position_map, piece);
+				m_aux_state.mmitset().apply_piecewise_map(position_map);
+			}
+		}
+		template<class _TPosition>
+		void insert_before_positions(const std::vector<std::pair<_TPosition, _Ty> >& position_value_pairs) {
+			insert_before_positions(position_value_pairs.begin(), position_value_pairs.end());
+		}
 		/* These insert() functions are just aliases for their corresponding insert_before() functions. */
 		ipointer insert(const ipointer &pos, size_t _M, const _Ty& _X) { return insert_before(pos, _M, _X); }
 		ipointer insert(const ipointer &pos, _Ty&& _X) { return insert_before(pos, std::move(_X)); }
@@ -1511,6 +4053,22 @@ namespace mse {
 			erase_previous_item(pos.item_pointer());
 			return pos;
 		}
+		/* Like erase_if(), but only considers the elements in [start, end). Returns end (which follows its element). */
+		template<class _TPredicate>
+		ipointer erase_if(const ipointer &start, const ipointer &end, _TPredicate pred) {
+			if ((&(start.item_pointer().m_owner_ref) != this) || (&(end.item_pointer().m_owner_ref) != this)) { throw(std::out_of_range("invalid arguments - ipointer erase_if() - msevector")); }
+			if (start.position() > end.position()) { throw(std::out_of_range("invalid arguments - ipointer erase_if() - msevector")); }
+			auto retval = end;
+			erase_if_in_range(mse::as_a_size_t(start.position()), mse::as_a_size_t(end.position()), pred);
+			return retval;
+		}
+		/* The ipointer version of splice(). Note that first (which points to the first element moved) is itself moved to this vector. */
+		void splice(const ipointer& dest_pos, _Myt& src, const ipointer& first, const ipointer& last) {
+			if ((dest_pos.m_owner_ptr != this) || (first.m_owner_ptr != &src) || (last.m_owner_ptr != &src)) {
+				throw(std::out_of_range("invalid arguments - void splice() - msevector"));
+			}
+			splice(dest_pos.position(), src, first.position(), last.position());
+		}
 
 
 		/* Note that, at the moment, ss_const_iterator_type inherits publicly from base_class::const_iterator. This is not intended to be a permanent
@@ -1530,23 +4088,15 @@ namespace mse {
 			typedef typename base_class::const_iterator::reference reference;
 			typedef typename base_class::const_reference const_reference;
 
-			ss_const_iterator_type() {}
+			ss_const_iterator_type() : m_index(0), m_buffer_generation_ptr(&unattached_buffer_generation()), m_buffer_generation(1), m_owner_size(0) {}
 			void reset() { set_to_end_marker(); }
 			bool points_to_an_item() const {
-				if ((1 <= m_owner_cptr->size()) && (m_index < m_owner_cptr->size())) { return true; }
-				else {
-					if (m_index == m_owner_cptr->size()) { return false; }
-					else { throw(std::out_of_range("attempt to use invalid ss_const_iterator_type - bool points_to_an_item() const - ss_const_iterator_type - msevector")); }
-				}
+				validate();
+				return (m_owner_size > m_index);
 			}
 			bool points_to_end_marker() const {
-				if (false == points_to_an_item()) {
-					if (m_index == m_owner_cptr->size()) {
-						return true;
-					}
-					else { throw(std::out_of_range("attempt to use invalid ss_const_iterator_type - bool points_to_end_marker() const - ss_const_iterator_type - msevector")); }
-				}
-				else { return false; }
+				validate();
+				return (m_owner_size == m_index);
 			}
 			bool points_to_beginning() const {
 				if (0 == m_index) { return true; }
@@ -1559,30 +4109,30 @@ namespace mse {
 			bool has_previous() const { return (!points_to_beginning()); }
 			void set_to_beginning() {
 				m_index = 0;
-				base_class::const_iterator::operator=(m_owner_cptr->cbegin());
+				sync_to_owner();
 			}
 			void set_to_end_marker() {
 				m_index = m_owner_cptr->size();
-				base_class::const_iterator::operator=(m_owner_cptr->cend());
+				sync_to_owner();
 			}
 			void set_to_next() {
 				if (points_to_an_item()) {
 					m_index += 1;
 					base_class::const_iterator::operator++();
-					if (m_owner_cptr->size() <= m_index) {
-						if (m_owner_cptr->size() < m_index) { assert(false); reset(); }
-					}
 				}
 				else {
+					m_owner_cptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - void set_to_next() - ss_const_iterator_type - msevector"));
 				}
 			}
 			void set_to_previous() {
+				validate();
 				if (has_previous()) {
 					m_index -= 1;
 					base_class::const_iterator::operator--();
 				}
 				else {
+					m_owner_cptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - void set_to_previous() - ss_const_iterator_type - msevector"));
 				}
 			}
@@ -1591,8 +4141,10 @@ namespace mse {
 			ss_const_iterator_type& operator --() { (*this).set_to_previous(); return (*this); }
 			ss_const_iterator_type operator--(int) { ss_const_iterator_type _Tmp = *this; --*this; return (_Tmp); }
 			void advance(difference_type n) {
+				validate();
 				auto new_index = CInt(m_index) + n;
-				if ((0 > new_index) || (m_owner_cptr->size() < new_index)) {
+				if ((0 > new_index) || (m_owner_size < new_index)) {
+					m_owner_cptr->note_bounds_check_failure();
 					throw(std::out_of_range("index out of range - void advance(difference_type n) - ss_const_iterator_type - msevector"));
 				}
 				else {
@@ -1604,42 +4156,42 @@ namespace mse {
 			ss_const_iterator_type& operator +=(difference_type n) { (*this).advance(n); return (*this); }
 			ss_const_iterator_type& operator -=(difference_type n) { (*this).regress(n); return (*this); }
 			ss_const_iterator_type operator+(difference_type n) const {
-				ss_const_iterator_type retval; retval.m_owner_cptr = m_owner_cptr;
-				retval = (*this);
+				ss_const_iterator_type retval = (*this);
 				retval.advance(n);
 				return retval;
 			}
 			ss_const_iterator_type operator-(difference_type n) const { return ((*this) + (-n)); }
 			difference_type operator-(const ss_const_iterator_type &rhs) const {
 				if (rhs.m_owner_cptr != (*this).m_owner_cptr) { throw(std::out_of_range("invalid argument - difference_type operator-(const ss_const_iterator_type &rhs) const - msevector::ss_const_iterator_type")); }
-				auto retval = (static_cast<const typename base_class::const_iterator&>(*this) - static_cast<const typename base_class::const_iterator&>(rhs));
-				assert((int)((*m_owner_cptr).size()) >= retval);
-				return retval;
+				/* (The positions are used rather than the base iterators, as one of them may be stale.) */
+				return (difference_type(mse::as_a_size_t(m_index)) - difference_type(mse::as_a_size_t(rhs.m_index)));
 			}
 			const_reference operator*() const {
 				if (points_to_an_item()) {
-					return m_owner_cptr->at(mse::as_a_size_t(m_index));
+					return base_class::const_iterator::operator*();
 				}
 				else {
+					m_owner_cptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - const_reference operator*() const - ss_const_iterator_type - msevector"));
 				}
 			}
 			const_reference item() const { return operator*(); }
 			const_reference previous_item() const {
+				validate();
 				if ((*this).has_previous()) {
-					return m_owner_cptr->at(m_index - 1);
+					return base_class::const_iterator::operator[](-1);
 				}
 				else {
+					m_owner_cptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - const_reference previous_item() const - ss_const_iterator_type - msevector"));
 				}
 			}
 			const_pointer operator->() const {
 				if (points_to_an_item()) {
-					const_cast<ss_const_iterator_type *>(this)->sync_const_iterator_to_index();
-					//sync_const_iterator_to_index();
 					return base_class::const_iterator::operator->();
 				}
 				else {
+					m_owner_cptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid const_item_pointer - pointer operator->() const - ss_const_iterator_type - msevector"));
 				}
 			}
@@ -1664,6 +4216,9 @@ namespace mse {
 			ss_const_iterator_type& operator=(const ss_const_iterator_type& _Right_cref) {
 				((*this).m_owner_cptr) = _Right_cref.m_owner_cptr;
 				(*this).m_index = _Right_cref.m_index;
+				(*this).m_buffer_generation_ptr = _Right_cref.m_buffer_generation_ptr;
+				(*this).m_buffer_generation = _Right_cref.m_buffer_generation;
+				(*this).m_owner_size = _Right_cref.m_owner_size;
 				base_class::const_iterator::operator=(_Right_cref);
 				return (*this);
 			}
@@ -1692,7 +4247,7 @@ namespace mse {
 					}
 					else {
 						(*this).m_index = new_index;
-						(*this).sync_const_iterator_to_index();
+						(*this).sync_to_owner();
 					}
 				}
 			}
@@ -1700,13 +4255,46 @@ namespace mse {
 				return m_index;
 			}
 		private:
-			void sync_const_iterator_to_index() {
-				assert(m_owner_cptr->size() >= (*this).m_index);
-				base_class::const_iterator::operator=(m_owner_cptr->cbegin());
-				base_class::const_iterator::operator+=(mse::as_a_size_t(m_index));
+			/* The (base) iterator is only used while the vector's buffer generation matches the one it was synced at. Any
+			mutation that changes the size of the vector, or reallocates its buffer, advances the generation, in which case the
+			iterator is resynced (from its position) on its next use. So in the common case dereferencing and incrementing cost
+			a single compare rather than rereading (and rechecking) the vector's size and buffer. */
+			void validate() const {
+				if ((*m_buffer_generation_ptr) != m_buffer_generation) { const_cast<ss_const_iterator_type *>(this)->resync_to_owner(); }
+			}
+			/* Unlike sync_to_owner(), this doesn't call (returning) functions, so validate() doesn't stop the compiler from
+			keeping the iterator, and the loop's other variables, in registers. (The buffer generation is held by the
+			vector's auxiliary state, which isn't deallocated while the vector exists. Default constructed iterators have
+			no vector, so they throw here.) */
+			void resync_to_owner() {
+				const size_t owner_size = m_owner_cptr->size();
+				if (owner_size < m_index) {
+					m_owner_cptr->note_bounds_check_failure();
+					throw(std::out_of_range("attempt to use invalid (stale) ss_const_iterator_type - void resync_to_owner() - ss_const_iterator_type - msevector"));
+				}
+				m_buffer_generation = (*m_buffer_generation_ptr);
+				m_owner_size = owner_size;
+				base_class::const_iterator::operator=(m_owner_cptr->base_class::cbegin() + mse::as_a_size_t(m_index));
+			}
+			void sync_to_owner() {
+				apply_snapshot(m_owner_cptr->buffer_generation_snapshot(mse::as_a_size_t(m_index)
+					, "attempt to use invalid (stale) ss_const_iterator_type - void sync_to_owner() - ss_const_iterator_type - msevector"));
+			}
+			void apply_snapshot(const CBufferGenerationSnapshot& snapshot) {
+				m_buffer_generation_ptr = snapshot.m_buffer_generation_ptr;
+				m_buffer_generation = snapshot.m_buffer_generation;
+				m_owner_size = snapshot.m_size;
+				base_class::const_iterator::operator=(snapshot.m_position_iterator);
+			}
+			const typename base_class::const_iterator& validated_base_iterator() const {
+				validate();
+				return (*this);
 			}
 			mse::CSize_t m_index;
 			TSaferPtrForLegacy<const _Myt> m_owner_cptr;
+			const size_t* m_buffer_generation_ptr;
+			size_t m_buffer_generation;
+			size_t m_owner_size;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
 		/* Note that, at the moment, ss_iterator_type inherits publicly from base_class::iterator. This is not intended to be a permanent
@@ -1724,23 +4312,15 @@ namespace mse {
 			typedef typename base_class::iterator::pointer pointer;
 			typedef typename base_class::iterator::reference reference;
 
-			ss_iterator_type() {}
+			ss_iterator_type() : m_index(0), m_buffer_generation_ptr(&unattached_buffer_generation()), m_buffer_generation(1), m_owner_size(0) {}
 			void reset() { set_to_end_marker(); }
 			bool points_to_an_item() const {
-				if ((1 <= m_owner_ptr->size()) && (m_index < m_owner_ptr->size())) { return true; }
-				else {
-					if (m_index == m_owner_ptr->size()) { return false; }
-					else { throw(std::out_of_range("attempt to use invalid ss_iterator_type - bool points_to_an_item() const - ss_iterator_type - msevector")); }
-				}
+				validate();
+				return (m_owner_size > m_index);
 			}
 			bool points_to_end_marker() const {
-				if (false == points_to_an_item()) {
-					if (m_index == m_owner_ptr->size()) {
-						return true;
-					}
-					else { throw(std::out_of_range("attempt to use invalid ss_iterator_type - bool points_to_end_marker() const - ss_iterator_type - msevector")); }
-				}
-				else { return false; }
+				validate();
+				return (m_owner_size == m_index);
 			}
 			bool points_to_beginning() const {
 				if (0 == m_index) { return true; }
@@ -1753,30 +4333,30 @@ namespace mse {
 			bool has_previous() const { return (!points_to_beginning()); }
 			void set_to_beginning() {
 				m_index = 0;
-				base_class::iterator::operator=(m_owner_ptr->begin());
+				sync_to_owner();
 			}
 			void set_to_end_marker() {
 				m_index = m_owner_ptr->size();
-				base_class::iterator::operator=(m_owner_ptr->end());
+				sync_to_owner();
 			}
 			void set_to_next() {
 				if (points_to_an_item()) {
 					m_index += 1;
 					base_class::iterator::operator++();
-					if (m_owner_ptr->size() <= m_index) {
-						if (m_owner_ptr->size() < m_index) { assert(false); reset(); }
-					}
 				}
 				else {
+					m_owner_ptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - void set_to_next() - ss_const_iterator_type - msevector"));
 				}
 			}
 			void set_to_previous() {
+				validate();
 				if (has_previous()) {
 					m_index -= 1;
 					base_class::iterator::operator--();
 				}
 				else {
+					m_owner_ptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - void set_to_previous() - ss_iterator_type - msevector"));
 				}
 			}
@@ -1785,8 +4365,10 @@ namespace mse {
 			ss_iterator_type& operator --() { (*this).set_to_previous(); return (*this); }
 			ss_iterator_type operator--(int) { ss_iterator_type _Tmp = *this; --*this; return (_Tmp); }
 			void advance(difference_type n) {
+				validate();
 				auto new_index = CInt(m_index) + n;
-				if ((0 > new_index) || (m_owner_ptr->size() < new_index)) {
+				if ((0 > new_index) || (m_owner_size < new_index)) {
+					m_owner_ptr->note_bounds_check_failure();
 					throw(std::out_of_range("index out of range - void advance(difference_type n) - ss_iterator_type - msevector"));
 				}
 				else {
@@ -1798,41 +4380,42 @@ namespace mse {
 			ss_iterator_type& operator +=(difference_type n) { (*this).advance(n); return (*this); }
 			ss_iterator_type& operator -=(difference_type n) { (*this).regress(n); return (*this); }
 			ss_iterator_type operator+(difference_type n) const {
-				ss_iterator_type retval; retval.m_owner_ptr = m_owner_ptr;
-				retval = (*this);
+				ss_iterator_type retval = (*this);
 				retval.advance(n);
 				return retval;
 			}
 			ss_iterator_type operator-(difference_type n) const { return ((*this) + (-n)); }
 			difference_type operator-(const ss_iterator_type& rhs) const {
 				if (rhs.m_owner_ptr != (*this).m_owner_ptr) { throw(std::out_of_range("invalid argument - difference_type operator-(const ss_iterator_type& rhs) const - msevector::ss_iterator_type")); }
-				auto retval = (static_cast<const typename base_class::iterator&>(*this) - static_cast<const typename base_class::iterator&>(rhs));
-				assert((int)((*m_owner_ptr).size()) >= retval);
-				return retval;
+				/* (The positions are used rather than the base iterators, as one of them may be stale.) */
+				return (difference_type(mse::as_a_size_t(m_index)) - difference_type(mse::as_a_size_t(rhs.m_index)));
 			}
 			reference operator*() {
 				if (points_to_an_item()) {
-					return m_owner_ptr->at(mse::as_a_size_t(m_index));
+					return base_class::iterator::operator*();
 				}
 				else {
+					m_owner_ptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - reference operator*() - ss_iterator_type - msevector"));
 				}
 			}
 			reference item() { return operator*(); }
 			reference previous_item() {
+				validate();
 				if ((*this).has_previous()) {
-					return m_owner_ptr->at(m_index - 1);
+					return base_class::iterator::operator[](-1);
 				}
 				else {
+					m_owner_ptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - reference previous_item() - ss_const_iterator_type - msevector"));
 				}
 			}
 			pointer operator->() {
 				if (points_to_an_item()) {
-					sync_iterator_to_index();
 					return base_class::iterator::operator->();
 				}
 				else {
+					m_owner_ptr->note_bounds_check_failure();
 					throw(std::out_of_range("attempt to use invalid item_pointer - pointer operator->() - ss_iterator_type - msevector"));
 				}
 			}
@@ -1857,6 +4440,9 @@ namespace mse {
 			ss_iterator_type& operator=(const ss_iterator_type& _Right_cref) {
 				((*this).m_owner_ptr) = _Right_cref.m_owner_ptr;
 				(*this).m_index = _Right_cref.m_index;
+				(*this).m_buffer_generation_ptr = _Right_cref.m_buffer_generation_ptr;
+				(*this).m_buffer_generation = _Right_cref.m_buffer_generation;
+				(*this).m_owner_size = _Right_cref.m_owner_size;
 				base_class::iterator::operator=(_Right_cref);
 				return (*this);
 			}
@@ -1885,7 +4471,7 @@ namespace mse {
 					}
 					else {
 						(*this).m_index = new_index;
-						(*this).sync_iterator_to_index();
+						(*this).sync_to_owner();
 					}
 				}
 			}
@@ -1894,20 +4480,50 @@ namespace mse {
 			}
 			operator ss_const_iterator_type() const {
 				ss_const_iterator_type retval;
-				if (m_owner_ptr == nullptr) {
+				if (m_owner_ptr != nullptr) {
 					retval = m_owner_ptr->ss_cbegin();
 					retval.advance(mse::CInt(m_index));
 				}
 				return retval;
 			}
 		private:
-			void sync_iterator_to_index() {
-				assert(m_owner_ptr->size() >= (*this).m_index);
-				base_class::iterator::operator=(m_owner_ptr->begin());
-				base_class::iterator::operator+=(mse::as_a_size_t(m_index));
+			/* (See ss_const_iterator_type.) */
+			void validate() const {
+				if ((*m_buffer_generation_ptr) != m_buffer_generation) { const_cast<ss_iterator_type *>(this)->resync_to_owner(); }
+			}
+			/* Unlike sync_to_owner(), this doesn't call (returning) functions, so validate() doesn't stop the compiler from
+			keeping the iterator, and the loop's other variables, in registers. (The buffer generation is held by the
+			vector's auxiliary state, which isn't deallocated while the vector exists. Default constructed iterators have
+			no vector, so they throw here.) */
+			void resync_to_owner() {
+				const size_t owner_size = m_owner_ptr->size();
+				if (owner_size < m_index) {
+					m_owner_ptr->note_bounds_check_failure();
+					throw(std::out_of_range("attempt to use invalid (stale) ss_iterator_type - void resync_to_owner() - ss_iterator_type - msevector"));
+				}
+				m_buffer_generation = (*m_buffer_generation_ptr);
+				m_owner_size = owner_size;
+				base_class::iterator::operator=(m_owner_ptr->base_class::begin() + mse::as_a_size_t(m_index));
+			}
+			void sync_to_owner() {
+				apply_snapshot(m_owner_ptr->buffer_generation_snapshot(mse::as_a_size_t(m_index)
+					, "attempt to use invalid (stale) ss_iterator_type - void sync_to_owner() - ss_iterator_type - msevector"));
+			}
+			void apply_snapshot(const CBufferGenerationSnapshot& snapshot) {
+				m_buffer_generation_ptr = snapshot.m_buffer_generation_ptr;
+				m_buffer_generation = snapshot.m_buffer_generation;
+				m_owner_size = snapshot.m_size;
+				base_class::iterator::operator=(snapshot.m_position_iterator);
+			}
+			const typename base_class::iterator& validated_base_iterator() const {
+				validate();
+				return (*this);
 			}
 			mse::CSize_t m_index;
 			TSaferPtrForLegacy<_Myt> m_owner_ptr;
+			const size_t* m_buffer_generation_ptr;
+			size_t m_buffer_generation;
+			size_t m_owner_size;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
 		typedef std::reverse_iterator<ss_iterator_type> ss_reverse_iterator_type;
@@ -1937,7 +4553,7 @@ namespace mse {
 		ss_const_iterator_type ss_end() const
 		{	// return base_class::iterator for end of nonmutable sequence
 			ss_const_iterator_type retval; retval.m_owner_cptr = this;
-			retval.set_to_set_to_end_marker();
+			retval.set_to_end_marker();
 			return retval;
 		}
 
@@ -1951,7 +4567,7 @@ namespace mse {
 		ss_const_iterator_type ss_cend() const
 		{	// return base_class::iterator for end of nonmutable sequence
 			ss_const_iterator_type retval; retval.m_owner_cptr = this;
-			retval.set_to_set_to_end_marker();
+			retval.set_to_end_marker();
 			return retval;
 		}
 
@@ -1986,27 +4602,27 @@ namespace mse {
 		}
 
 		msevector(const ss_const_iterator_type &start, const ss_const_iterator_type &end, const _A& _Al = _A())
-			: base_class(static_cast<typename base_class::const_iterator>(start), static_cast<typename base_class::const_iterator>(end), _Al), m_mmitset(*this) {
-			m_debug_size = size();
+			: base_class(start.validated_base_iterator(), end.validated_base_iterator(), _Al) {
+			update_debug_size();
 		}
 		void assign(const ss_const_iterator_type &start, const ss_const_iterator_type &end) {
 			if (start.m_owner_cptr != end.m_owner_cptr) { throw(std::out_of_range("invalid arguments - void assign(const ss_const_iterator_type &start, const ss_const_iterator_type &end) - msevector")); }
-			typename base_class::const_iterator _F = start;
-			typename base_class::const_iterator _L = end;
+			typename base_class::const_iterator _F = start.validated_base_iterator();
+			typename base_class::const_iterator _L = end.validated_base_iterator();
 			(*this).assign(_F, _L);
 		}
 		void assign_inclusive(const ss_const_iterator_type &first, const ss_const_iterator_type &last) {
-			if (first.m_owner_cref != last.m_owner_cref) { throw(std::out_of_range("invalid arguments - void assign_inclusive(const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
-			if (!(last.points_to_item())) { throw(std::out_of_range("invalid argument - void assign_inclusive(const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
-			typename base_class::const_iterator _F = first;
-			typename base_class::const_iterator _L = last;
+			if (first.m_owner_cptr != last.m_owner_cptr) { throw(std::out_of_range("invalid arguments - void assign_inclusive(const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
+			if (!(last.points_to_an_item())) { throw(std::out_of_range("invalid argument - void assign_inclusive(const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
+			typename base_class::const_iterator _F = first.validated_base_iterator();
+			typename base_class::const_iterator _L = last.validated_base_iterator();
 			_L++;
 			(*this).assign(_F, _L);
 		}
 		ss_iterator_type insert_before(const ss_iterator_type &pos, size_t _M, const _Ty& _X) {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void insert_before() - msevector")); }
 			CSize_t original_pos = pos.position();
-			typename base_class::iterator _P = pos;
+			typename base_class::iterator _P = pos.validated_base_iterator();
 			(*this).insert(_P, _M, _X);
 			ss_iterator_type retval = ss_begin();
 			retval.advance((CInt)original_pos);
@@ -2015,7 +4631,7 @@ namespace mse {
 		ss_iterator_type insert_before(const ss_iterator_type &pos, _Ty&& _X) {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void insert_before() - msevector")); }
 			CSize_t original_pos = pos.position();
-			typename base_class::iterator _P = pos;
+			typename base_class::iterator _P = pos.validated_base_iterator();
 			(*this).insert(_P, std::move(_X));
 			ss_iterator_type retval = ss_begin();
 			retval.advance((CInt)original_pos);
@@ -2026,9 +4642,9 @@ namespace mse {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void insert_before() - msevector")); }
 			if (start.m_owner_cptr != end.m_owner_cptr) { throw(std::out_of_range("invalid arguments - void insert_before(const ss_const_iterator_type &pos, const ss_const_iterator_type &start, const ss_const_iterator_type &end) - msevector")); }
 			CSize_t original_pos = pos.position();
-			typename base_class::iterator _P = pos;
-			typename base_class::const_iterator _F = start;
-			typename base_class::const_iterator _L = end;
+			typename base_class::iterator _P = pos.validated_base_iterator();
+			typename base_class::const_iterator _F = start.validated_base_iterator();
+			typename base_class::const_iterator _L = end.validated_base_iterator();
 			(*this).insert(_P, _F, _L);
 			ss_iterator_type retval = ss_begin();
 			retval.advance((CInt)original_pos);
@@ -2038,7 +4654,7 @@ namespace mse {
 		ss_iterator_type insert_before(const ss_iterator_type &pos, const _Ty* start, const _Ty* &end) {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void insert_before() - msevector")); }
 			CSize_t original_pos = pos.position();
-			typename base_class::iterator _P = pos;
+			typename base_class::iterator _P = pos.validated_base_iterator();
 			(*this).insert(_P, start, end);
 			ss_iterator_type retval = ss_begin();
 			retval.advance((CInt)original_pos);
@@ -2046,12 +4662,12 @@ namespace mse {
 		}
 		ss_iterator_type insert_before_inclusive(const ss_iterator_type &pos, const ss_const_iterator_type &first, const ss_const_iterator_type &last) {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void insert_before() - msevector")); }
-			if (first.m_owner_cref != last.m_owner_cref) { throw(std::out_of_range("invalid arguments - void insert_before_inclusive(const ss_iterator_type &pos, const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
-			if (!(last.points_to_item())) { throw(std::out_of_range("invalid argument - void insert_before_inclusive(const ss_iterator_type &pos, const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
+			if (first.m_owner_cptr != last.m_owner_cptr) { throw(std::out_of_range("invalid arguments - void insert_before_inclusive(const ss_iterator_type &pos, const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
+			if (!(last.points_to_an_item())) { throw(std::out_of_range("invalid argument - void insert_before_inclusive(const ss_iterator_type &pos, const ss_const_iterator_type &first, const ss_const_iterator_type &last) - msevector")); }
 			CSize_t original_pos = pos.position();
-			typename base_class::iterator _P = pos;
-			typename base_class::const_iterator _F = first;
-			typename base_class::const_iterator _L = last;
+			typename base_class::iterator _P = pos.validated_base_iterator();
+			typename base_class::const_iterator _F = first.validated_base_iterator();
+			typename base_class::const_iterator _L = last.validated_base_iterator();
 			_L++;
 			(*this).insert(_P, _F, _L);
 			ss_iterator_type retval = ss_begin();
@@ -2062,7 +4678,7 @@ namespace mse {
 		ss_iterator_type insert_before(const ss_iterator_type &pos, _XSTD initializer_list<typename base_class::value_type> _Ilist) {	// insert initializer_list
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void insert_before() - msevector")); }
 			CSize_t original_pos = pos.position();
-			typename base_class::iterator _P = pos;
+			typename base_class::iterator _P = pos.validated_base_iterator();
 			(*this).insert(_P, _Ilist);
 			ss_iterator_type retval = ss_begin();
 			retval.advance((CInt)original_pos);
@@ -2081,7 +4697,7 @@ namespace mse {
 #endif /*MSVC2010_COMPATIBILE*/
 		ss_iterator_type erase(const ss_iterator_type &pos) {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void erase() - msevector")); }
-			typename base_class::iterator _P = pos;
+			typename base_class::iterator _P = pos.validated_base_iterator();
 			auto retval = pos;
 			static_cast<typename base_class::iterator&>(retval) = (*this).erase(_P);
 			return retval;
@@ -2089,8 +4705,8 @@ namespace mse {
 		ss_iterator_type erase(const ss_iterator_type &start, const ss_iterator_type &end) {
 			if (start.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void erase() - msevector")); }
 			if (end.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void erase() - msevector")); }
-			typename base_class::iterator _F = start;
-			typename base_class::iterator _L = end;
+			typename base_class::iterator _F = start.validated_base_iterator();
+			typename base_class::iterator _L = end.validated_base_iterator();
 			auto retval = start;
 			static_cast<typename base_class::iterator&>(retval) = (*this).erase(_F, _L);
 			return retval;
@@ -2098,9 +4714,9 @@ namespace mse {
 		ss_iterator_type erase_inclusive(const ss_iterator_type &first, const ss_iterator_type &last) {
 			if (first.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void erase_inclusive() - msevector")); }
 			if (last.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void erase_inclusive() - msevector")); }
-			if (!(last.points_to_item())) { throw(std::out_of_range("invalid argument - void erase_inclusive() - msevector")); }
-			typename base_class::iterator _F = first;
-			typename base_class::iterator _L = last;
+			if (!(last.points_to_an_item())) { throw(std::out_of_range("invalid argument - void erase_inclusive() - msevector")); }
+			typename base_class::iterator _F = first.validated_base_iterator();
+			typename base_class::iterator _L = last.validated_base_iterator();
 			_L++;
 			auto retval = first;
 			static_cast<typename base_class::iterator&>(retval) = (*this).erase(_F, _L);
@@ -2109,10 +4725,258 @@ namespace mse {
 		void erase_previous_item(const ss_iterator_type &pos) {
 			if (pos.m_owner_ptr != this) { throw(std::out_of_range("invalid arguments - void erase_previous_item() - msevector")); }
 			if (!(pos.has_previous())) { throw(std::out_of_range("invalid arguments - void erase_previous_item() - msevector")); }
-			typename base_class::iterator _P = pos;
+			typename base_class::iterator _P = pos.validated_base_iterator();
 			_P--;
 			(*this).erase(_P);
 		}
+
+		/* An irange tracks a contiguous range, [begin, end), of the vector's elements. It's an alternative to a pair of
+		ipointers that uses a single registry entry, and as both ends are updated by the same fixup, they can't get out of
+		order. Elements inserted inside the range (i.e. after its first element and before its end) become part of it, while
+		elements inserted at either end don't. Removing elements of the range shrinks it (possibly to empty). Elements moved
+		within the vector (by splice()) take the ends of the range with them, but permutations of the elements (like sort())
+		leave the range's positions unchanged. If the vector is cleared or reassigned, the range becomes an empty range at the
+		end of the vector. Access to the range's elements is bounds checked against the range. The irange must not outlive
+		the vector. */
+		class irange {
+		public:
+			typedef typename base_class::value_type value_type;
+			typedef typename base_class::reference reference;
+			typedef ss_iterator_type iterator;
+
+			irange(_Myt& owner_ref, CSize_t begin_position, CSize_t end_position) : m_owner_ptr(&owner_ref)
+				, m_range_index(owner_ref.allocate_new_tracked_range(begin_position, end_position)) {}
+			irange(const irange& src_cref) : m_owner_ptr(src_cref.m_owner_ptr)
+				, m_range_index(m_owner_ptr->allocate_new_tracked_range(src_cref.begin_position(), src_cref.end_position())) {}
+			~irange() {
+				m_owner_ptr->release_tracked_range(m_range_index);
+			}
+			irange& operator=(const irange& _Right_cref) {
+				if (_Right_cref.m_owner_ptr != m_owner_ptr) { throw(std::out_of_range("invalid argument - irange& operator=() - msevector::irange")); }
+				m_owner_ptr->m_aux_state.mmitset().set_tracked_range(m_range_index, _Right_cref.tracked_begin(), _Right_cref.tracked_end());
+				return (*this);
+			}
+
+			CSize_t begin_position() const { return CSize_t(tracked_begin()); }
+			CSize_t end_position() const { return CSize_t(tracked_end()); }
+			size_t size() const { return (tracked_end() - tracked_begin()); }
+			bool empty() const { return (tracked_end() == tracked_begin()); }
+			/* Sets the range to [begin_position, end_position). */
+			void set_range(CSize_t begin_position, CSize_t end_position) {
+				if ((begin_position > end_position) || (CSize_t(m_owner_ptr->size()) < end_position)) {
+					m_owner_ptr->note_bounds_check_failure();
+					throw(std::out_of_range("invalid range - void set_range() - msevector::irange"));
+				}
+				m_owner_ptr->m_aux_state.mmitset().set_tracked_range(m_range_index, mse::as_a_size_t(begin_position), mse::as_a_size_t(end_position));
+			}
+
+			reference operator[](size_t index) const {
+				if ((size() <= index) || (m_owner_ptr->size() <= tracked_begin() + index)) {
+					m_owner_ptr->note_bounds_check_failure();
+					throw(std::out_of_range("index out of range - reference operator[]() - msevector::irange"));
+				}
+				return m_owner_ptr->base_class::operator[](tracked_begin() + index);
+			}
+			reference at(size_t index) const { return (*this)[index]; }
+			reference front() const { return (*this)[0]; }
+			reference back() const {
+				if (empty()) { m_owner_ptr->note_bounds_check_failure(); throw(std::out_of_range("empty range - reference back() - msevector::irange")); }
+				return (*this)[size() - 1];
+			}
+			/* The (checked) iterators to the range's current contents. */
+			iterator begin() const {
+				iterator retval = m_owner_ptr->ss_begin();
+				retval.advance(typename iterator::difference_type(tracked_begin()));
+				return retval;
+			}
+			iterator end() const {
+				iterator retval = m_owner_ptr->ss_begin();
+				retval.advance(typename iterator::difference_type(tracked_end()));
+				return retval;
+			}
+		private:
+			size_t tracked_begin() const { return m_owner_ptr->m_aux_state.mmitset().tracked_range_begin(m_range_index); }
+			size_t tracked_end() const { return m_owner_ptr->m_aux_state.mmitset().tracked_range_end(m_range_index); }
+
+			_Myt* m_owner_ptr;
+			size_t m_range_index;
+			friend class /*_Myt*/msevector<_Ty, _A>;
+		};
+		irange make_irange(CSize_t begin_position, CSize_t end_position) { return irange(*this, begin_position, end_position); }
+
+		/* A weak_ipointer refers to a position in the vector, like an ipointer, but it isn't registered with the vector, so it
+		adds no cost to the vector's mutations (or to its own construction and destruction), beyond the one time allocation of
+		the vector's auxiliary state if no ipointer has done so already. Rather than being kept up to date, it records the
+		vector's structure version when it's set, and any subsequent insertion, removal or reordering of the vector's elements
+		(including clear(), assignment, swap() and moves) makes it stale. Reallocations and assignments to the
+		elements themselves don't. Dereferencing a stale weak_ipointer throws, as does dereferencing one that points to the end
+		marker. It's intended for rarely dereferenced cached positions, where it's enough to know whether the cached position can
+		still be trusted. The weak_ipointer must not outlive the vector. */
+		class weak_ipointer {
+		public:
+			typedef typename base_class::value_type value_type;
+			typedef typename base_class::reference reference;
+			typedef typename base_class::pointer pointer;
+
+			weak_ipointer(_Myt& owner_ref, CSize_t position) : m_owner_ptr(&owner_ref), m_position(checked_position(owner_ref, position))
+				, m_structure_version(owner_ref.m_aux_state.allocated().m_structure_version) {}
+			weak_ipointer(const ipointer& src_cref) : m_owner_ptr(src_cref.m_owner_ptr), m_position(mse::as_a_size_t(src_cref.position()))
+				, m_structure_version(m_owner_ptr->m_aux_state.allocated().m_structure_version) {}
+
+			/* Whether the vector has been structurally modified since the position was set. */
+			bool is_stale() const { return (m_owner_ptr->m_aux_state.structure_version() != m_structure_version); }
+			bool is_valid() const { return (!is_stale()); }
+			bool points_to_an_item() const { return ((!is_stale()) && (m_owner_ptr->size() > m_position)); }
+			bool points_to_end_marker() const { return ((!is_stale()) && (m_owner_ptr->size() == m_position)); }
+			/* The position as of when it was set (whether or not it's stale). */
+			CSize_t position() const { return CSize_t(m_position); }
+			/* Sets the position (and makes the weak_ipointer current again). */
+			void set_position(CSize_t position) {
+				m_position = checked_position(*m_owner_ptr, position);
+				m_structure_version = m_owner_ptr->m_aux_state.structure_version();
+			}
+			/* A (registered) ipointer to the same position. Throws if stale. */
+			ipointer to_ipointer() const {
+				if (is_stale()) { m_owner_ptr->note_bounds_check_failure(); throw(std::out_of_range("stale weak_ipointer - ipointer to_ipointer() - msevector::weak_ipointer")); }
+				ipointer retval(*m_owner_ptr);
+				retval.advance(mse::CInt(CSize_t(m_position)));
+				return retval;
+			}
+			reference operator*() const {
+				if (!points_to_an_item()) {
+					m_owner_ptr->note_bounds_check_failure();
+					if (is_stale()) { throw(std::out_of_range("stale weak_ipointer - reference operator*() - msevector::weak_ipointer")); }
+					throw(std::out_of_range("attempt to dereference end marker - reference operator*() - msevector::weak_ipointer"));
+				}
+				return m_owner_ptr->base_class::operator[](m_position);
+			}
+			reference item() const { return operator*(); }
+			pointer operator->() const { return std::addressof(operator*()); }
+			bool operator==(const weak_ipointer& _Right_cref) const { return ((m_owner_ptr == _Right_cref.m_owner_ptr) && (m_position == _Right_cref.m_position)); }
+			bool operator!=(const weak_ipointer& _Right_cref) const { return (!(_Right_cref == (*this))); }
+		private:
+			static size_t checked_position(const _Myt& owner_cref, CSize_t position) {
+				if (CSize_t(owner_cref.size()) < position) {
+					owner_cref.note_bounds_check_failure();
+					throw(std::out_of_range("index out of range - weak_ipointer() - msevector::weak_ipointer"));
+				}
+				return mse::as_a_size_t(position);
+			}
+
+			_Myt* m_owner_ptr;
+			size_t m_position;
+			size_t m_structure_version;
+			friend class /*_Myt*/msevector<_Ty, _A>;
+		};
+		weak_ipointer make_weak_ipointer(CSize_t position) { return weak_ipointer(*this, position); }
+	};
+
+	/* The reference count policies for TRefCountedMsevectorPtr's storage (and so for mstd::vector, ivector and their
+	iterators and ipointers). */
+
+	/* The default. It's safe to share between threads, like std::shared_ptr's. (With libstdc++ it uses the same primitives as
+	std::shared_ptr, which skip the atomic instructions while the program is single threaded.) */
+	class msevector_atomic_reference_count {
+	public:
+		msevector_atomic_reference_count() : m_count(1) {}
+#ifdef __GLIBCXX__
+		void add_reference() { __gnu_cxx::__atomic_add_dispatch(&m_count, 1); }
+		/* Returns whether the released reference was the last one. */
+		bool release_reference() { return (1 == __gnu_cxx::__exchange_and_add_dispatch(&m_count, -1)); }
+		size_t count() const { return size_t(__atomic_load_n(&m_count, __ATOMIC_RELAXED)); }
+	private:
+		_Atomic_word m_count;
+#else /*__GLIBCXX__*/
+		void add_reference() { m_count.fetch_add(1, std::memory_order_relaxed); }
+		/* Returns whether the released reference was the last one. */
+		bool release_reference() { return (1 == m_count.fetch_sub(1, std::memory_order_acq_rel)); }
+		size_t count() const { return m_count.load(std::memory_order_relaxed); }
+	private:
+		std::atomic<size_t> m_count;
+#endif /*__GLIBCXX__*/
+	};
+
+	/* A plain (non-atomic) count, for containers (and their iterators) that are only ever used from one thread. In debug
+	builds (i.e. unless NDEBUG is defined) it asserts that it's only used from the thread that created it. (The creating
+	thread's id is kept regardless, so that the layout doesn't depend on NDEBUG, which may differ between translation
+	units.) */
+	class msevector_single_threaded_reference_count {
+	public:
+#ifndef MSVC2010_COMPATIBILE
+		msevector_single_threaded_reference_count() : m_count(1), m_thread_id(std::this_thread::get_id()) {}
+#else /*!MSVC2010_COMPATIBILE*/
+		msevector_single_threaded_reference_count() : m_count(1) {}
+#endif /*!MSVC2010_COMPATIBILE*/
+		void add_reference() { assert_same_thread(); m_count += 1; }
+		/* Returns whether the released reference was the last one. */
+		bool release_reference() { assert_same_thread(); m_count -= 1; return (0 == m_count); }
+		size_t count() const { return m_count; }
+	private:
+		size_t m_count;
+#ifndef MSVC2010_COMPATIBILE
+		bool is_creating_thread() const { return (std::this_thread::get_id() == m_thread_id); }
+		void assert_same_thread() const { assert(is_creating_thread() && "single threaded container used from another thread"); }
+		std::thread::id m_thread_id;
+#else /*!MSVC2010_COMPATIBILE*/
+		void assert_same_thread() const {}
+#endif /*!MSVC2010_COMPATIBILE*/
+	};
+
+	/* A reference counting pointer to a msevector that's allocated together with its (intrusive) reference count, so that
+	sharing a msevector costs a single allocation (where a std::shared_ptr to a new'ed msevector needs a second one for its
+	control block). It's what mstd::vector and ivector (and their iterators and ipointers) use to share ownership of their
+	msevector. */
+	template<class _TMV, class _TRefCount = msevector_atomic_reference_count>
+	class TRefCountedMsevectorPtr {
+	public:
+		TRefCountedMsevectorPtr() : m_storage_ptr(nullptr) {}
+		/* Allocates the shared storage, moving the given msevector into it (which is constant time and doesn't allocate). */
+		explicit TRefCountedMsevectorPtr(_TMV&& src) : m_storage_ptr(new CStorage(std::move(src))) {}
+		TRefCountedMsevectorPtr(const TRefCountedMsevectorPtr& src_cref) : m_storage_ptr(src_cref.m_storage_ptr) { add_reference(); }
+		TRefCountedMsevectorPtr(TRefCountedMsevectorPtr&& src) MSE_MSEVECTOR_MOVE_NOEXCEPT : m_storage_ptr(src.m_storage_ptr) { src.m_storage_ptr = nullptr; }
+		~TRefCountedMsevectorPtr() { release_reference(); }
+		TRefCountedMsevectorPtr& operator=(const TRefCountedMsevectorPtr& _Right_cref) {
+			/* (The new reference is added first in case both refer to the same storage.) */
+			CStorage* storage_ptr = _Right_cref.m_storage_ptr;
+			if (storage_ptr) { storage_ptr->m_reference_count.add_reference(); }
+			release_reference();
+			m_storage_ptr = storage_ptr;
+			return (*this);
+		}
+		TRefCountedMsevectorPtr& operator=(TRefCountedMsevectorPtr&& _Right) MSE_MSEVECTOR_MOVE_NOEXCEPT {
+			if (std::addressof(_Right) == this) { return (*this); }
+			release_reference();
+			m_storage_ptr = _Right.m_storage_ptr;
+			_Right.m_storage_ptr = nullptr;
+			return (*this);
+		}
+		void reset() { release_reference(); m_storage_ptr = nullptr; }
+
+		_TMV* get() const { return (m_storage_ptr) ? std::addressof(m_storage_ptr->m_msevector) : nullptr; }
+		_TMV& operator*() const { assert(m_storage_ptr); return m_storage_ptr->m_msevector; }
+		_TMV* operator->() const { assert(m_storage_ptr); return std::addressof(m_storage_ptr->m_msevector); }
+		bool operator!() const { return (nullptr == m_storage_ptr); }
+		bool operator==(const TRefCountedMsevectorPtr& _Right_cref) const { return (m_storage_ptr == _Right_cref.m_storage_ptr); }
+		bool operator!=(const TRefCountedMsevectorPtr& _Right_cref) const { return (m_storage_ptr != _Right_cref.m_storage_ptr); }
+		size_t use_count() const { return (m_storage_ptr) ? m_storage_ptr->m_reference_count.count() : 0; }
+
+	private:
+		class CStorage {
+		public:
+			CStorage(_TMV&& src) : m_msevector(std::move(src)) {}
+			_TMV m_msevector;
+			_TRefCount m_reference_count;
+		};
+		void add_reference() {
+			if (m_storage_ptr) { m_storage_ptr->m_reference_count.add_reference(); }
+		}
+		void release_reference() {
+			if (m_storage_ptr && m_storage_ptr->m_reference_count.release_reference()) {
+				delete m_storage_ptr;
+			}
+		}
+
+		CStorage* m_storage_ptr;
 	};
 
 }
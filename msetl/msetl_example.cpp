@@ -59,8 +59,8 @@ int main(int argc, char* argv[])
 		auto vi_it = vvi[0].begin();
 		vvi.clear();
 		/* At this point, the vint_type object is cleared from vvi, but it has not been deallocated/destructed yet because it
-		"knows" that there is an iterator, namely vi_it, that is still referencing it. At the moment, std::shared_ptrs are being
-		used to achieve this. */
+		"knows" that there is an iterator, namely vi_it, that is still referencing it. (The vector and its iterators share
+		ownership of it through a reference count.) */
 		auto value = (*vi_it); /* So this is actually ok. vi_it still points to a valid item. */
 		assert(5 == value);
 		vint_type vi2;
@@ -13,8 +13,26 @@
 #include "msemstdvector.h"
 #include "mseivector.h"
 #include <algorithm>    // std::sort
+#include <sstream>
+#include <iterator>
+#include <cstring>
+#include <memory>
 
 namespace mse {
+	/* A plain record with user-provided copy operations (so it isn't trivially copyable), that opts in to being relocated
+	bitwise by msevector. */
+	class CRelocatableRecord {
+	public:
+		CRelocatableRecord(int value = 0) : m_value(value), m_self_check(value * 3) {}
+		CRelocatableRecord(const CRelocatableRecord& src_cref) : m_value(src_cref.m_value), m_self_check(src_cref.m_self_check) {}
+		CRelocatableRecord& operator=(const CRelocatableRecord& _Right_cref) { m_value = _Right_cref.m_value; m_self_check = _Right_cref.m_self_check; return (*this); }
+		bool is_intact() const { return (m_value * 3 == m_self_check); }
+		int m_value;
+		int m_self_check;
+	};
+	template<>
+	struct msevector_is_trivially_relocatable<CRelocatableRecord> : public std::true_type {};
+
 	class msevector_test {
 	public:
 		/* This is a unit test for mse::msevector. It was originally swiped from stlport (http://www.stlport.org/). */
@@ -60,6 +78,30 @@ namespace mse {
 			mse::CInt resm5 = msevector_test1.msevec_test_m5();
 			mse::CInt resm6 = msevector_test1.msevec_test_m6();
 			mse::CInt resm7 = msevector_test1.msevec_test_m7();
+			mse::CInt resm8 = msevector_test1.msevec_test_m8();
+			mse::CInt resm9 = msevector_test1.msevec_test_m9();
+			mse::CInt resm10 = msevector_test1.msevec_test_m10();
+			mse::CInt resm11 = msevector_test1.msevec_test_m11();
+			mse::CInt resm12 = msevector_test1.msevec_test_m12();
+			mse::CInt resm13 = msevector_test1.msevec_test_m13();
+			mse::CInt resm14 = msevector_test1.msevec_test_m14();
+			mse::CInt resm15 = msevector_test1.msevec_test_m15();
+			mse::CInt resm16 = msevector_test1.msevec_test_m16();
+			mse::CInt resm17 = msevector_test1.msevec_test_m17();
+			mse::CInt resm18 = msevector_test1.msevec_test_m18();
+			mse::CInt resm19 = msevector_test1.msevec_test_m19();
+			mse::CInt resm20 = msevector_test1.msevec_test_m20();
+			mse::CInt resm21 = msevector_test1.msevec_test_m21();
+			mse::CInt resm22 = msevector_test1.msevec_test_m22();
+			mse::CInt resm23 = msevector_test1.msevec_test_m23();
+			mse::CInt resm24 = msevector_test1.msevec_test_m24();
+			mse::CInt resm25 = msevector_test1.msevec_test_m25();
+			mse::CInt resm26 = msevector_test1.msevec_test_m26();
+			mse::CInt resm27 = msevector_test1.msevec_test_m27();
+			mse::CInt resm28 = msevector_test1.msevec_test_m28();
+			mse::CInt resm29 = msevector_test1.msevec_test_m29();
+			mse::CInt resm30 = msevector_test1.msevec_test_m30();
+			mse::CInt resm31 = msevector_test1.msevec_test_m31();
 			mse::CInt resi1 = msevector_test1.msevec_test_i1();
 			mse::CInt resi2 = msevector_test1.msevec_test_i2();
 			mse::CInt resi3 = msevector_test1.msevec_test_i3();
@@ -76,7 +118,7 @@ namespace mse {
 			mse::CInt ress7 = msevector_test1.msevec_test_s7();
 			mse::CInt res_mvec_as_stdvec = res1 + res2 + res3 + res4 + res5 + res6 + res7 + res_cap + res_at + res_ptr + res_aref
 				/*+ res_oc */ + res_asschk + res_its + res_ebo + res_bvec1;
-			mse::CInt res_mvec = resm1 + resm2 + resm3 + resm4 + resm5 + resm6 + resm7;
+			mse::CInt res_mvec = resm1 + resm2 + resm3 + resm4 + resm5 + resm6 + resm7 + resm8 + resm9 + resm10 + resm11 + resm12 + resm13 + resm14 + resm15 + resm16 + resm17 + resm18 + resm19 + resm20 + resm21 + resm22 + resm23 + resm24 + resm25 + resm26 + resm27 + resm28 + resm29 + resm30 + resm31;
 			mse::CInt res_ivec = resi1 + resi2 + resi3 + resi4 + resi5 + resi6 + resi7;
 			mse::CInt res_svec = ress1 + ress2 + ress3 + ress4 + ress5 + ress6 + ress7;
 			mse::CInt resall = res_mvec_as_stdvec + res_mvec + res_ivec + res_svec;
@@ -1031,6 +1073,1576 @@ namespace mse {
 			return EXAM_RESULT;
 		}
 
+		CInt msevec_test_m8()
+		{
+			/* Exercises the reuse of ipointer registry slots. */
+			msevector<int> v;
+			for (int i = 0; i < 10; i += 1) { v.push_back(i); }
+
+			msevector<msevector<int>::ipointer> ips;
+			for (int i = 0; i < 200; i += 1) {
+				msevector<int>::ipointer ip(v);
+				ip.advance(i % 10);
+				ips.push_back(ip);
+			}
+			EXAM_CHECK(200 == ips.size());
+			for (int i = 0; i < 200; i += 2) {
+				ips.erase(ips.begin() + (ips.size() - 1 - i / 2));
+			}
+			EXAM_CHECK(100 == ips.size());
+			for (int i = 0; i < 100; i += 1) {
+				msevector<int>::ipointer ip(v);
+				ip.advance(i % 10);
+				ips.push_back(ip);
+			}
+			EXAM_CHECK(200 == ips.size());
+
+			msevector<int>::ipointer ip0 = v.ibegin();
+			v.insert_before(ip0, -1);
+			for (size_t i = 0; i < ips.size(); i += 1) {
+				if (ips[i].points_to_an_item()) {
+					EXAM_CHECK(*(ips[i]) == v[mse::as_a_size_t(ips[i].position())]);
+					EXAM_CHECK(1 <= ips[i].position());
+				}
+			}
+			msevector<int>::cipointer cip(v);
+			cip.advance(5);
+			EXAM_CHECK(4 == *cip);
+			v.erase(v.ibegin());
+			EXAM_CHECK(4 == *cip);
+			EXAM_CHECK(4 == cip.position());
+
+			ips.clear();
+			msevector<int>::ipointer ip1(v);
+			ip1.set_to_end_marker();
+			ip1.set_to_previous();
+			EXAM_CHECK(9 == *ip1);
+
+			return EXAM_RESULT;
+		}
+
+
+		CInt msevec_test_m9()
+		{
+			/* Exercises the position ordered ipointer registry with a mix of mutations and ipointer movements, checking each
+			ipointer against the value (or end marker) it is expected to refer to. */
+			msevector<int> v;
+			for (int i = 0; i < 100; i += 1) { v.push_back(i); }
+
+			msevector<msevector<int>::ipointer> ips;
+			msevector<int> expected_values;
+			for (int i = 0; i < 100; i += 1) {
+				msevector<int>::ipointer ip(v);
+				ip.advance(i);
+				ips.push_back(ip);
+				expected_values.push_back(i);
+			}
+			for (int i = 0; i < 5; i += 1) {
+				ips.push_back(v.iend());
+				expected_values.push_back(-1);
+			}
+			msevector<int>::cipointer cip(v);
+			cip.advance(60);
+
+			for (int step = 0; step < 7; step += 1) {
+				switch (step) {
+				case 0:
+					/* ipointers to erased items become end markers */
+					v.erase(v.begin() + 40, v.begin() + 50);
+					for (int i = 40; i < 50; i += 1) { expected_values[i] = -1; }
+					break;
+				case 1:
+					v.insert(v.begin() + 10, 7, 1000);
+					break;
+				case 2:
+					for (size_t i = 0; i < ips.size(); i += 3) {
+						if (ips[i].points_to_an_item()) {
+							CSize_t new_pos = ips[i].position() + 1;
+							ips[i].set_to_next();
+							expected_values[i] = (v.size() > new_pos) ? v[mse::as_a_size_t(new_pos)] : -1;
+						}
+					}
+					break;
+				case 3:
+					v.push_back(2000);
+					v.push_back(2001);
+					v.pop_back();
+					break;
+				case 4:
+					for (size_t i = 0; i < ips.size(); i += 1) {
+						if (ips[i].points_to_an_item() && (0 == ips[i].position())) { expected_values[i] = -1; }
+					}
+					v.erase(v.begin());
+					break;
+				case 5:
+					for (size_t i = 0; i < ips.size(); i += 1) {
+						if (ips[i].points_to_an_item() && (v.size() - 1 == ips[i].position())) { expected_values[i] = -1; }
+					}
+					v.erase(v.begin() + (v.size() - 1));
+					break;
+				default:
+					ips[7].set_to_end_marker();
+					expected_values[7] = -1;
+					ips[8].set_to_beginning();
+					expected_values[8] = v[0];
+					v.insert(v.begin() + 20, 3000);
+					break;
+				}
+				for (size_t i = 0; i < ips.size(); i += 1) {
+					if (-1 == expected_values[i]) {
+						EXAM_CHECK(ips[i].points_to_end_marker());
+					}
+					else {
+						EXAM_CHECK(ips[i].points_to_an_item());
+						EXAM_CHECK(expected_values[i] == *(ips[i]));
+					}
+				}
+				EXAM_CHECK(60 == *cip);
+			}
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m10()
+		{
+			/* Exercises the (lazy) replay of mutations on ipointers that go many mutations (more than the mutation log holds)
+			between accesses. */
+			msevector<int> v;
+			int next_value = 0;
+			for (; next_value < 300; next_value += 1) { v.push_back(next_value); }
+
+			msevector<msevector<int>::ipointer> ips;
+			msevector<int> expected_values;
+			for (int i = 0; i < 300; i += 7) {
+				msevector<int>::ipointer ip(v);
+				ip.advance(i);
+				ips.push_back(ip);
+				expected_values.push_back(i);
+			}
+			ips.push_back(v.iend());
+			expected_values.push_back(-1);
+
+			unsigned int seed = 12345;
+			for (int round = 0; round < 4; round += 1) {
+				int number_of_mutations = (0 == round) ? 10 : 700;
+				for (int i = 0; i < number_of_mutations; i += 1) {
+					seed = seed * 1103515245 + 12345;
+					size_t pos = (seed >> 8) % v.size();
+					if (0 == (seed >> 20) % 2) {
+						v.insert(v.begin() + pos, next_value);
+						next_value += 1;
+					}
+					else {
+						for (size_t j = 0; j < expected_values.size(); j += 1) {
+							if (v[pos] == expected_values[j]) { expected_values[j] = -1; }
+						}
+						v.erase(v.begin() + pos);
+					}
+				}
+				for (size_t j = 0; j < ips.size(); j += 1) {
+					if (-1 == expected_values[j]) {
+						EXAM_CHECK(ips[j].points_to_end_marker());
+					}
+					else {
+						EXAM_CHECK(expected_values[j] == *(ips[j]));
+					}
+				}
+			}
+
+			/* The log fills up (and the iterators are brought up to date) in the middle of operations that shrink the vector. */
+			for (int k = 0; k < 3; k += 1) {
+				msevector<int> v2;
+				for (int i = 0; i < 40; i += 1) { v2.push_back(i); }
+				msevector<int>::ipointer ip1(v2);
+				ip1.advance(39);
+				msevector<int>::cipointer cip1(v2);
+				cip1.advance(30);
+				for (int i = 0; i < 16; i += 1) { v2.insert_before(0, 100 + i); }
+				if (0 == k) {
+					v2.erase(v2.begin(), v2.begin() + 10);
+					EXAM_CHECK((46 == v2.size()) && (39 == *ip1) && (30 == *cip1));
+				}
+				else if (1 == k) {
+					v2.resize(50);
+					EXAM_CHECK(ip1.points_to_end_marker() && (30 == *cip1));
+				}
+				else {
+					v2.erase(v2.begin() + 50, v2.end());
+					EXAM_CHECK(ip1.points_to_end_marker() && (30 == *cip1) && (50 == v2.size()));
+				}
+			}
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m11()
+		{
+			/* Exercises end marker ipointers (which track the end of the vector symbolically) through appends, pops and
+			reallocations. */
+			msevector<int> v;
+			msevector<int>::ipointer end_ip = v.iend();
+			msevector<int>::cipointer end_cip = v.iend();
+			msevector<msevector<int>::ipointer> ips;
+			for (int i = 0; i < 1000; i += 1) {
+				if (0 == i % 100) {
+					ips.push_back(v.iend());
+				}
+				v.push_back(i);
+				if (0 == i % 10) {
+					EXAM_CHECK(end_ip.points_to_end_marker());
+					EXAM_CHECK(v.size() == end_ip.position());
+				}
+			}
+			/* ipointers obtained from iend() before the push_back()s still point to the end marker */
+			for (size_t j = 0; j < ips.size(); j += 1) {
+				EXAM_CHECK(ips[j].points_to_end_marker());
+			}
+			v.emplace_back(1000);
+			end_ip.set_to_previous();
+			EXAM_CHECK(1000 == *end_ip);
+			v.pop_back();
+			EXAM_CHECK(end_ip.points_to_end_marker());
+			EXAM_CHECK(end_cip.points_to_end_marker());
+			EXAM_CHECK(1000 == end_cip.position());
+			v.shrink_to_fit();
+			end_cip.set_to_previous();
+			EXAM_CHECK(999 == *end_cip);
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m12()
+		{
+			/* Exercises ipointers (which rederive their base iterators lazily) through reallocations. */
+			msevector<int> v;
+			v.push_back(0);
+			v.shrink_to_fit();
+			msevector<int>::ipointer ip1(v);
+			msevector<int>::cipointer cip1(v);
+			for (int i = 1; i < 100; i += 1) {
+				v.push_back(i);
+				if (0 == i % 10) {
+					ip1.advance(10);
+					EXAM_CHECK(i == *ip1);
+					*ip1 += 1000;
+					EXAM_CHECK(1000 + i == v[i]);
+				}
+			}
+			EXAM_CHECK(0 == *cip1);
+			v.reserve(v.capacity() * 4);
+			cip1.set_to_next();
+			EXAM_CHECK(1 == *cip1);
+			EXAM_CHECK(1090 == *ip1);
+			v.insert(v.begin(), 3, -1);
+			v.shrink_to_fit();
+			EXAM_CHECK(1090 == *ip1);
+			EXAM_CHECK(1 == *cip1);
+			EXAM_CHECK(&(v[93]) == &(*ip1));
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m13()
+		{
+			/* Exercises mutation batches by applying the same (pseudo-random) edits to two vectors, one of them in batches,
+			and comparing the ipointers into each. */
+			msevector<int> v1;
+			msevector<int> v2;
+			for (int i = 0; i < 200; i += 1) { v1.push_back(i); v2.push_back(i); }
+			msevector<msevector<int>::ipointer> ips1;
+			msevector<msevector<int>::ipointer> ips2;
+			for (int i = 0; i < 200; i += 3) {
+				ips1.push_back(v1.ibegin() + i);
+				ips2.push_back(v2.ibegin() + i);
+			}
+			ips1.push_back(v1.iend());
+			ips2.push_back(v2.iend());
+
+			unsigned int seed = 54321;
+			for (int round = 0; round < 5; round += 1) {
+				auto batch = v2.begin_batch(50);
+				{
+					auto nested_batch = v2.begin_batch();
+					for (int i = 0; i < 60; i += 1) {
+						seed = seed * 1103515245 + 12345;
+						size_t pos = (seed >> 8) % v1.size();
+						if (0 == (seed >> 20) % 3) {
+							v1.erase(v1.begin() + pos);
+							v2.erase(v2.begin() + pos);
+						}
+						else {
+							v1.insert(v1.begin() + pos, -1);
+							v2.insert(v2.begin() + pos, -1);
+						}
+						if (0 == i % 20) {
+							/* ipointers remain usable during a batch */
+							EXAM_CHECK(ips1[5].position() == ips2[5].position());
+							ips1[7].set_to_beginning();
+							ips2[7].set_to_beginning();
+						}
+					}
+				}
+				if (0 == round % 2) { batch.commit(); }
+			}
+			for (size_t j = 0; j < ips1.size(); j += 1) {
+				EXAM_CHECK(ips1[j].points_to_an_item() == ips2[j].points_to_an_item());
+				EXAM_CHECK(ips1[j].position() == ips2[j].position());
+			}
+			v1.erase(v1.begin(), v1.begin() + 10);
+			v2.erase(v2.begin(), v2.begin() + 10);
+			for (size_t j = 0; j < ips1.size(); j += 1) {
+				EXAM_CHECK(ips1[j].position() == ips2[j].position());
+			}
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m14()
+		{
+			/* Exercises savepoints. Mutations are rolled back and the contents and ipointers are compared against their
+			state at the savepoint. */
+			msevector<int> v1;
+			for (int i = 0; i < 100; i += 1) { v1.push_back(i); }
+			msevector<int> v1_copy = v1;
+			msevector<int>::ipointer ip1 = v1.ibegin() + 10;
+			msevector<int>::ipointer ip2 = v1.ibegin() + 70;
+			msevector<int>::ipointer ip3 = v1.iend();
+
+			auto sp1 = v1.savepoint();
+			v1.insert(v1.begin() + 5, 3, -1);
+			v1.erase(v1.begin() + 50, v1.begin() + 60);
+			for (int i = 0; i < 20; i += 1) { v1.push_back(-2); }
+			auto sp2 = v1.savepoint();
+			v1.pop_back();
+			v1.erase(v1.begin());
+			v1.resize(40);
+			EXAM_CHECK(40 == v1.size());
+			EXAM_CHECK(2 == v1.number_of_savepoints());
+
+			v1.rollback(sp2);
+			EXAM_CHECK(2 == v1.number_of_savepoints());
+			EXAM_CHECK(113 == v1.size());
+			EXAM_CHECK(-2 == v1.back());
+			EXAM_CHECK(-1 == v1[5]);
+			EXAM_CHECK(10 == *ip1);
+			EXAM_CHECK(13 == ip1.position());
+			/* ip2's item was removed by the resize(), and restoring the item doesn't restore the ipointer */
+			EXAM_CHECK(!ip2.points_to_an_item());
+
+			{
+				msevector<int> v2 = v1;
+				auto sp3 = v2.savepoint();
+				v2.clear();
+				v2.assign(3, 7);
+				msevector<int> v3(5, 1);
+				v2.swap(v3);
+				v2.rollback(sp3);
+				EXAM_CHECK(v2 == v1);
+				EXAM_CHECK(1 == v2.number_of_savepoints());
+				v2.release(sp3);
+				EXAM_CHECK(0 == v2.number_of_savepoints());
+			}
+
+			v1.erase(v1.begin() + 20, v1.end());
+			v1.insert(v1.begin(), 4, 9);
+			v1.rollback(sp1);
+			EXAM_CHECK(1 == v1.number_of_savepoints());
+			EXAM_CHECK(v1 == v1_copy);
+			EXAM_CHECK(10 == *ip1);
+			EXAM_CHECK(10 == ip1.position());
+			EXAM_CHECK(v1.iend() == ip3);
+
+			/* sp2 was discarded by the rollback to sp1 */
+			try {
+				v1.rollback(sp2);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			v1.erase(v1.begin() + 10);
+			EXAM_CHECK(!ip1.points_to_an_item());
+			v1.release(sp1);
+			EXAM_CHECK(0 == v1.number_of_savepoints());
+			EXAM_CHECK(99 == v1.size());
+			try {
+				v1.release(sp1);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			/* Savepoints aren't supported for non-copyable element types, but the journaling mustn't get in the way of the
+			other operations. */
+			msevector<std::unique_ptr<int> > v3;
+			for (int i = 0; i < 4; i += 1) { v3.push_back(std::unique_ptr<int>(new int(i))); }
+			v3.erase(v3.begin());
+			v3.erase(v3.begin(), v3.begin() + 1);
+			v3.pop_back();
+			EXAM_CHECK((1 == v3.size()) && (2 == *(v3[0])));
+			msevector<std::unique_ptr<int> > v4;
+			v3.swap(v4);
+			v4.clear();
+			EXAM_CHECK(v3.empty() && v4.empty());
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m15()
+		{
+			/* A vector's ipointer registry is only allocated when an ipointer is first created. */
+#if !(defined(MSE_MSEVECTOR_DEBUG_SIZE) || defined(MSE_MSEVECTOR_INSTRUMENTATION))
+			EXAM_CHECK(sizeof(std::vector<int>) + sizeof(void*) == sizeof(msevector<int>));
+#endif /*!(defined(MSE_MSEVECTOR_DEBUG_SIZE) || defined(MSE_MSEVECTOR_INSTRUMENTATION))*/
+			msevector<int> v1;
+			for (int i = 0; i < 50; i += 1) { v1.push_back(i); }
+			v1.erase(v1.begin() + 10, v1.begin() + 20);
+			v1.insert(v1.begin(), 2, -1);
+			v1.clear();
+			for (int i = 0; i < 50; i += 1) { v1.push_back(i); }
+			{
+				auto batch = v1.begin_batch();
+				v1.erase(v1.begin());
+			}
+
+			msevector<int>::ipointer ip1 = v1.ibegin() + 20;
+			EXAM_CHECK(21 == *ip1);
+			v1.insert(v1.begin(), 5, -1);
+			EXAM_CHECK(21 == *ip1);
+			EXAM_CHECK(25 == ip1.position());
+
+			msevector<int> v2 = v1;
+			msevector<int>::cipointer cip2(v2);
+			v2.erase(v2.begin());
+			EXAM_CHECK(!cip2.points_to_an_item());
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m16()
+		{
+			/* Checks the instrumentation counts (when MSE_MSEVECTOR_INSTRUMENTATION is defined). */
+#ifdef MSE_MSEVECTOR_INSTRUMENTATION
+			msevector_instrumentation_counts global_counts_before = msevector_global_instrumentation::counts();
+			msevector<int> v1;
+			for (int i = 0; i < 100; i += 1) { v1.push_back(i); }
+			EXAM_CHECK(100 == v1.instrumentation_counts().m_shift_inclusive_range_calls);
+			EXAM_CHECK(0 == v1.instrumentation_counts().m_iterators_visited);
+			EXAM_CHECK(v1.instrumentation_counts().m_reallocations == v1.instrumentation_counts().m_sync_iterators_to_index_calls);
+			EXAM_CHECK(1 <= v1.instrumentation_counts().m_reallocations);
+			{
+				msevector<int>::ipointer ip1 = v1.ibegin() + 50;
+				msevector<int>::ipointer ip2 = v1.ibegin() + 60;
+				msevector<int>::cipointer cip1(v1);
+				EXAM_CHECK(3 == v1.instrumentation_counts().m_live_ipointers);
+				v1.erase(v1.begin() + 55);
+				EXAM_CHECK(1 == v1.instrumentation_counts().m_invalidate_inclusive_range_calls);
+				EXAM_CHECK(1 <= v1.instrumentation_counts().m_iterators_visited);
+				EXAM_CHECK(60 == *ip2);
+				EXAM_CHECK(59 == ip2.position());
+			}
+			EXAM_CHECK(0 == v1.instrumentation_counts().m_live_ipointers);
+			EXAM_CHECK(3 == v1.instrumentation_counts().m_peak_live_ipointers);
+			try {
+				v1[200] = 1;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK(1 == v1.instrumentation_counts().m_bounds_check_failures);
+
+			msevector_instrumentation_counts global_counts_after = msevector_global_instrumentation::counts();
+			EXAM_CHECK(global_counts_before.m_shift_inclusive_range_calls + v1.instrumentation_counts().m_shift_inclusive_range_calls
+				<= global_counts_after.m_shift_inclusive_range_calls);
+			EXAM_CHECK(global_counts_before.m_bounds_check_failures + 1 <= global_counts_after.m_bounds_check_failures);
+			std::string json = v1.instrumentation_counts().as_json();
+			EXAM_CHECK(std::string::npos != json.find("\"bounds_check_failures\": 1"));
+#endif /*MSE_MSEVECTOR_INSTRUMENTATION*/
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m17()
+		{
+			/* Exercises erase_if(). */
+			msevector<int> v1;
+			for (int i = 0; i < 100; i += 1) { v1.push_back(i); }
+			msevector<msevector<int>::ipointer> ips;
+			for (int i = 0; i < 100; i += 1) { ips.push_back(v1.ibegin() + i); }
+			msevector<int>::ipointer end_ip = v1.iend();
+			msevector<int>::cipointer cip1(v1);
+			cip1.advance(99);
+
+			auto sp1 = v1.savepoint();
+			size_t number_removed = v1.erase_if([](int x) { return (0 == x % 3) || ((40 <= x) && (60 > x)); });
+			EXAM_CHECK(number_removed == 100 - v1.size());
+			for (int i = 0; i < 100; i += 1) {
+				bool removed = (0 == i % 3) || ((40 <= i) && (60 > i));
+				EXAM_CHECK(removed != ips[i].points_to_an_item());
+				if (!removed) {
+					EXAM_CHECK(i == *(ips[i]));
+				}
+			}
+			EXAM_CHECK(v1.iend() == end_ip);
+			EXAM_CHECK(!cip1.points_to_an_item());
+			for (size_t j = 0; j < v1.size(); j += 1) {
+				EXAM_CHECK((0 != v1[j] % 3) && ((40 > v1[j]) || (60 <= v1[j])));
+			}
+
+			v1.rollback(sp1);
+			v1.release(sp1);
+			EXAM_CHECK(100 == v1.size());
+			for (int i = 0; i < 100; i += 1) {
+				EXAM_CHECK(i == v1[i]);
+			}
+			/* restoring the elements doesn't restore the ipointers to them */
+			EXAM_CHECK(!ips[50].points_to_an_item());
+			EXAM_CHECK(61 == *(ips[61]));
+
+			/* the ipointer range variant, during a batch and with a throwing predicate */
+			msevector<int>::ipointer start_ip = v1.ibegin() + 10;
+			msevector<int>::ipointer stop_ip = v1.ibegin() + 20;
+			{
+				auto batch = v1.begin_batch();
+				v1.erase(v1.begin());
+				auto ip = v1.erase_if(start_ip, stop_ip, [](int x) { return (0 == x % 2); });
+				EXAM_CHECK(20 == *ip);
+			}
+			EXAM_CHECK(94 == v1.size());
+			EXAM_CHECK(9 == v1[8]);
+			EXAM_CHECK(11 == v1[9]);
+			EXAM_CHECK(19 == v1[13]);
+			EXAM_CHECK(20 == v1[14]);
+			EXAM_CHECK(!start_ip.points_to_an_item());
+			EXAM_CHECK(20 == *stop_ip);
+			EXAM_CHECK(22 == *(ips[22]));
+			EXAM_CHECK(16 == ips[22].position());
+
+			try {
+				v1.erase_if([](int x) { if (50 <= x) { throw(std::out_of_range("test")); } return (30 > x); });
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK(70 == v1.size());
+			EXAM_CHECK(30 == v1[0]);
+			EXAM_CHECK(61 == *(ips[61]));
+			EXAM_CHECK(31 == ips[61].position());
+
+			msevector<std::unique_ptr<int> > v3;
+			for (int i = 0; i < 10; i += 1) { v3.push_back(std::unique_ptr<int>(new int(i))); }
+			EXAM_CHECK(5 == v3.erase_if([](const std::unique_ptr<int>& ptr) { return (0 == ((*ptr) % 2)); }));
+			EXAM_CHECK((5 == v3.size()) && (9 == *(v3.back())));
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m18()
+		{
+			/* Exercises insert_before_positions() by comparing it against a sequence of single insertions. */
+			msevector<int> v1;
+			for (int i = 0; i < 50; i += 1) { v1.push_back(i); }
+			msevector<int> v2 = v1;
+			msevector<msevector<int>::ipointer> ips1;
+			msevector<msevector<int>::ipointer> ips2;
+			for (int i = 0; i < 50; i += 7) {
+				ips1.push_back(v1.ibegin() + i);
+				ips2.push_back(v2.ibegin() + i);
+			}
+			ips1.push_back(v1.iend());
+			ips2.push_back(v2.iend());
+
+			std::vector<std::pair<size_t, int> > position_value_pairs;
+			position_value_pairs.push_back(std::make_pair(size_t(0), -1));
+			position_value_pairs.push_back(std::make_pair(size_t(7), -2));
+			position_value_pairs.push_back(std::make_pair(size_t(7), -3));
+			position_value_pairs.push_back(std::make_pair(size_t(20), -4));
+			position_value_pairs.push_back(std::make_pair(size_t(50), -5));
+			auto sp1 = v1.savepoint();
+			v1.insert_before_positions(position_value_pairs);
+			for (size_t k = 0; k < position_value_pairs.size(); k += 1) {
+				v2.insert_before(CSize_t(position_value_pairs[k].first + k), position_value_pairs[k].second);
+			}
+			EXAM_CHECK(v1 == v2);
+			for (size_t j = 0; j < ips1.size(); j += 1) {
+				EXAM_CHECK(ips1[j].position() == ips2[j].position());
+			}
+			EXAM_CHECK(7 == *(ips1[1]));
+			EXAM_CHECK(v1.iend() == ips1.back());
+
+			v1.rollback(sp1);
+			v1.release(sp1);
+			EXAM_CHECK(50 == v1.size());
+			EXAM_CHECK(7 == *(ips1[1]));
+			EXAM_CHECK(7 == ips1[1].position());
+
+			/* positions must be sorted */
+			position_value_pairs[1].first = 30;
+			try {
+				v1.insert_before_positions(position_value_pairs);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK(50 == v1.size());
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m19()
+		{
+			/* Exercises append_range() and append_generated(). */
+			msevector<int> v1;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(i); }
+			msevector<int>::ipointer ip1 = v1.ibegin() + 5;
+			msevector<int>::ipointer end_ip = v1.iend();
+			auto sp1 = v1.savepoint();
+
+			std::vector<int> source;
+			for (int i = 10; i < 20; i += 1) { source.push_back(i); }
+			v1.append_range(source);
+			EXAM_CHECK(20 == v1.size());
+			EXAM_CHECK(v1.iend() == end_ip);
+
+			/* input iterators (which can only be traversed once) with a size hint */
+			std::istringstream iss("20 21 22 23 24");
+			v1.append_range(std::istream_iterator<int>(iss), std::istream_iterator<int>(), 5);
+			EXAM_CHECK(25 == v1.size());
+			EXAM_CHECK(24 == v1.back());
+
+			int next_value = 25;
+			v1.append_generated(5, [&next_value]() { return next_value++; });
+			EXAM_CHECK(30 == v1.size());
+			for (int i = 0; i < 30; i += 1) {
+				EXAM_CHECK(i == v1[i]);
+			}
+			EXAM_CHECK(5 == *ip1);
+			EXAM_CHECK(v1.iend() == end_ip);
+
+			/* a generator that throws partway */
+			try {
+				v1.append_generated(5, [&next_value]() { if (33 <= next_value) { throw(std::out_of_range("test")); } return next_value++; });
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK(33 == v1.size());
+			EXAM_CHECK(v1.iend() == end_ip);
+
+			v1.rollback(sp1);
+			v1.release(sp1);
+			EXAM_CHECK(10 == v1.size());
+			EXAM_CHECK(v1.iend() == end_ip);
+
+			/* insert() from input iterators */
+			std::istringstream iss2("-1 -2 -3");
+			v1.insert(v1.begin() + 2, std::istream_iterator<int>(iss2), std::istream_iterator<int>());
+			EXAM_CHECK(13 == v1.size());
+			EXAM_CHECK(-3 == v1[4]);
+			EXAM_CHECK(5 == *ip1);
+			EXAM_CHECK(8 == ip1.position());
+
+			/* repeated small appends grow the capacity geometrically (rather than reallocating on each one) */
+			msevector<int> v2;
+			size_t number_of_reallocations = 0;
+			const int one_two[2] = { 1, 2 };
+			for (int i = 0; i < 1000; i += 1) {
+				const size_t previous_capacity = v2.capacity();
+				if (0 == (i % 2)) {
+					v2.append_generated(1, [i]() { return i; });
+				}
+				else {
+					v2.append_range(std::begin(one_two), std::end(one_two));
+				}
+				if (v2.capacity() != previous_capacity) { number_of_reallocations += 1; }
+			}
+			EXAM_CHECK((1500 == v2.size()) && (2 * v2.size() >= v2.capacity()));
+			EXAM_CHECK(20 > number_of_reallocations);
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m20()
+		{
+			/* Exercises sort(), stable_sort(), nth_element() and apply_permutation(). */
+			msevector<int> v1;
+			for (int i = 0; i < 50; i += 1) { v1.push_back((i * 37) % 50); }
+			msevector<msevector<int>::ipointer> ips;
+			for (int i = 0; i < 50; i += 1) { ips.push_back(v1.ibegin() + i); }
+			msevector<int>::cipointer cip1(v1);
+			cip1.advance(3);
+			const int cip1_value = *cip1;
+			msevector<int>::ipointer end_ip = v1.iend();
+
+			v1.sort();
+			for (int i = 0; i < 50; i += 1) {
+				EXAM_CHECK(i == v1[i]);
+				EXAM_CHECK(((i * 37) % 50) == *(ips[i]));
+				EXAM_CHECK(((i * 37) % 50) == ips[i].position());
+			}
+			EXAM_CHECK(cip1_value == *cip1);
+			EXAM_CHECK(v1.iend() == end_ip);
+
+			v1.sort(std::greater<int>());
+			for (int i = 0; i < 50; i += 1) {
+				EXAM_CHECK((49 - i) == v1[i]);
+				EXAM_CHECK(49 - ((i * 37) % 50) == ips[i].position());
+			}
+
+			/* stable_sort() keeps equal elements (and so their ipointers) in order */
+			v1.stable_sort([](int a, int b) { return (a % 5) < (b % 5); });
+			for (int i = 1; i < 50; i += 1) {
+				EXAM_CHECK(((v1[i - 1] % 5) < (v1[i] % 5)) || (((v1[i - 1] % 5) == (v1[i] % 5)) && (v1[i - 1] > v1[i])));
+			}
+			for (int i = 0; i < 50; i += 1) {
+				EXAM_CHECK(((i * 37) % 50) == *(ips[i]));
+			}
+
+			v1.nth_element(25);
+			EXAM_CHECK(25 == v1[25]);
+			for (int i = 0; i < 50; i += 1) {
+				EXAM_CHECK(((i * 37) % 50) == *(ips[i]));
+				EXAM_CHECK((25 > i) == (25 > v1[i]));
+			}
+			EXAM_CHECK(cip1_value == *cip1);
+
+			/* reverse */
+			std::vector<size_t> old_positions;
+			for (size_t i = 0; i < 50; i += 1) { old_positions.push_back(49 - i); }
+			std::vector<int> expected_values;
+			for (size_t i = 0; i < 50; i += 1) { expected_values.push_back(v1[49 - i]); }
+			v1.apply_permutation(old_positions);
+			for (int i = 0; i < 50; i += 1) {
+				EXAM_CHECK(expected_values[i] == v1[i]);
+				EXAM_CHECK(((i * 37) % 50) == *(ips[i]));
+			}
+
+			old_positions[0] = old_positions[1];
+			try {
+				v1.apply_permutation(old_positions);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			old_positions.pop_back();
+			try {
+				v1.apply_permutation(old_positions);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			try {
+				v1.nth_element(50);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK(expected_values[0] == v1[0]);
+
+			/* without any registered ipointers */
+			msevector<int> v2;
+			for (int i = 0; i < 10; i += 1) { v2.push_back(9 - i); }
+			v2.sort();
+			for (int i = 0; i < 10; i += 1) {
+				EXAM_CHECK(i == v2[i]);
+			}
+
+			/* reorderings are rolled back along with the other mutations */
+			msevector<int> v3;
+			for (int i = 0; i < 20; i += 1) { v3.push_back((i * 7) % 20); }
+			const msevector<int> v3_copy = v3;
+			auto sp1 = v3.savepoint();
+			v3.erase(v3.begin() + 5);
+			v3.sort();
+			v3.insert(v3.begin(), 3, 100);
+			msevector<int>::ipointer ip1 = v3.ibegin() + 10;
+			const int ip1_value = *ip1;
+			v3.stable_sort(std::greater<int>());
+			v3.nth_element(4);
+			std::vector<size_t> reversal;
+			for (size_t i = 0; i < v3.size(); i += 1) { reversal.push_back(v3.size() - 1 - i); }
+			v3.apply_permutation(reversal);
+			EXAM_CHECK(ip1_value == *ip1);
+			v3.rollback(sp1);
+			EXAM_CHECK((v3 == v3_copy) && (ip1_value == *ip1));
+			auto sp2 = v3.savepoint();
+			v3.sort();
+			v3.rollback(sp2);
+			EXAM_CHECK(v3 == v3_copy);
+			v3.release(sp1);
+			EXAM_CHECK(0 == v3.number_of_savepoints());
+
+			/* a reordering that throws discards the savepoints */
+			auto sp3 = v3.savepoint();
+			int number_of_comparisons = 0;
+			try {
+				v3.sort([&number_of_comparisons](int a, int b) {
+					number_of_comparisons += 1;
+					if (10 < number_of_comparisons) { throw(std::out_of_range("test")); }
+					return (a < b);
+				});
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK(0 == v3.number_of_savepoints());
+			auto sp4 = v3.savepoint();
+			try {
+				v3.rollback(sp3);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			v3.release(sp4);
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m21()
+		{
+			/* Exercises splice(). */
+			msevector<int> v1;
+			msevector<int> v2;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(i); v2.push_back(100 + i); }
+			msevector<msevector<int>::ipointer> ips1;
+			for (int i = 0; i < 10; i += 1) { ips1.push_back(v1.ibegin() + i); }
+			msevector<int>::cipointer cip1 = v1.cibegin();
+			cip1.advance(4);
+			msevector<int>::ipointer v2_ip = v2.ibegin() + 5;
+			msevector<int>::ipointer v1_end_ip = v1.iend();
+			auto sp1 = v1.savepoint();
+
+			/* move v1[3..7) to before v2[2] */
+			v2.splice(2, v1, 3, 7);
+			EXAM_CHECK(6 == v1.size());
+			EXAM_CHECK(14 == v2.size());
+			EXAM_CHECK(7 == v1[3]);
+			EXAM_CHECK(101 == v2[1]);
+			EXAM_CHECK(3 == v2[2]);
+			EXAM_CHECK(6 == v2[5]);
+			EXAM_CHECK(102 == v2[6]);
+			for (int i = 0; i < 10; i += 1) {
+				EXAM_CHECK(i == *(ips1[i]));
+			}
+			EXAM_CHECK(4 == *cip1);
+			EXAM_CHECK(3 == cip1.position());
+			EXAM_CHECK(4 == ips1[5].position());
+			EXAM_CHECK(3 == ips1[7].position());
+			EXAM_CHECK(105 == *v2_ip);
+			EXAM_CHECK(9 == v2_ip.position());
+			EXAM_CHECK(v1.iend() == v1_end_ip);
+			/* the moved ipointers now belong to v2 */
+			EXAM_CHECK(ips1[4] - v2.ibegin() == 3);
+			ips1[4] += 3;
+			EXAM_CHECK(102 == *(ips1[4]));
+			ips1[4] -= 3;
+			v2.erase(ips1[3]);
+			EXAM_CHECK(4 == *(ips1[4]));
+			EXAM_CHECK(!ips1[3].points_to_an_item());
+
+			v1.rollback(sp1);
+			v1.release(sp1);
+			EXAM_CHECK(10 == v1.size());
+			EXAM_CHECK(7 == *(ips1[7]));
+			EXAM_CHECK(7 == ips1[7].position());
+
+			/* within one vector */
+			msevector<int>::ipointer ip7 = v1.ibegin() + 7;
+			v1.splice(1, v1, 6, 9);
+			EXAM_CHECK(10 == v1.size());
+			EXAM_CHECK(0 == v1[0]);
+			EXAM_CHECK(6 == v1[1]);
+			EXAM_CHECK(8 == v1[3]);
+			EXAM_CHECK(1 == v1[4]);
+			EXAM_CHECK(5 == v1[8]);
+			EXAM_CHECK(9 == v1[9]);
+			EXAM_CHECK(7 == *ip7);
+			EXAM_CHECK(2 == ip7.position());
+			EXAM_CHECK(1 == *(ips1[1]));
+			EXAM_CHECK(4 == ips1[1].position());
+			v1.splice(10, v1, 0, 2);
+			EXAM_CHECK(7 == v1[0]);
+			EXAM_CHECK(0 == v1[8]);
+			EXAM_CHECK(6 == v1[9]);
+			EXAM_CHECK(7 == *ip7);
+			EXAM_CHECK(0 == ip7.position());
+			try {
+				v1.splice(4, v1, 3, 6);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			/* the ipointer version (first moves along with its element) */
+			msevector<int>::ipointer first_ip = v1.ibegin() + 1;
+			msevector<int>::ipointer last_ip = v1.ibegin() + 3;
+			const int first_value = *first_ip;
+			const int last_value = *last_ip;
+			v2.splice(v2.iend(), v1, first_ip, last_ip);
+			EXAM_CHECK(8 == v1.size());
+			EXAM_CHECK(first_value == *first_ip);
+			EXAM_CHECK(first_ip.position() + 2 == v2.size());
+			EXAM_CHECK(last_value == *last_ip);
+			EXAM_CHECK(1 == last_ip.position());
+			try {
+				v2.splice(v1.ibegin(), v1, first_ip, last_ip);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			/* rolling back a splice (with elements whose moved-from state differs from the original) */
+			msevector<std::string> v3;
+			msevector<std::string> v4;
+			for (int i = 0; i < 4; i += 1) { v3.push_back(std::string(40, char('a' + i))); }
+			const msevector<std::string> v3_copy = v3;
+			auto sp2 = v3.savepoint();
+			v4.splice(0, v3, 1, 3);
+			EXAM_CHECK((2 == v3.size()) && (std::string(40, 'b') == v4[0]) && (std::string(40, 'c') == v4[1]));
+			v3.rollback(sp2);
+			EXAM_CHECK(v3 == v3_copy);
+			msevector<std::string>::ipointer ip8 = v3.ibegin() + 3;
+			v3.splice(0, v3, 2, 4);
+			v3.splice(4, v3, 0, 1);
+			EXAM_CHECK((std::string(40, 'd') == v3[0]) && (std::string(40, 'c') == v3[3]) && (0 == ip8.position()));
+			v3.rollback(sp2);
+			v3.release(sp2);
+			EXAM_CHECK((v3 == v3_copy) && (3 == ip8.position()));
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m22()
+		{
+			/* Exercises the bitwise relocation of (opted in) trivially relocatable element types. */
+			EXAM_CHECK(_mse_msevector_relocates_bitwise<CRelocatableRecord>::value);
+			/* (std::vector already moves trivially copyable types with memmove().) */
+			EXAM_CHECK(!_mse_msevector_relocates_bitwise<int>::value);
+			EXAM_CHECK(!_mse_msevector_relocates_bitwise<msevector<int> >::value);
+			EXAM_CHECK(!_mse_msevector_relocates_bitwise<bool>::value);
+
+			msevector<CRelocatableRecord> v1;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(CRelocatableRecord(i)); }
+			msevector<CRelocatableRecord>::ipointer ip5 = v1.ibegin() + 5;
+			auto sp1 = v1.savepoint();
+
+			v1.insert(v1.begin() + 2, CRelocatableRecord(100));
+			v1.insert(v1.begin() + 4, 3, CRelocatableRecord(200));
+			v1.emplace(v1.begin(), 300);
+			std::vector<CRelocatableRecord> source;
+			for (int i = 0; i < 4; i += 1) { source.push_back(CRelocatableRecord(400 + i)); }
+			v1.insert(v1.end() - 1, source.begin(), source.end());
+			v1.insert(v1.begin() + 1, v1[5]);
+			const int expected[] = { 300, 200, 0, 1, 100, 2, 200, 200, 200, 3, 4, 5, 6, 7, 8, 400, 401, 402, 403, 9 };
+			EXAM_CHECK(20 == v1.size());
+			for (size_t i = 0; v1.size() > i; i += 1) {
+				EXAM_CHECK(expected[i] == v1[i].m_value);
+				EXAM_CHECK(v1[i].is_intact());
+			}
+			EXAM_CHECK(5 == (*ip5).m_value);
+			EXAM_CHECK(11 == ip5.position());
+
+			v1.erase(v1.begin() + 6, v1.begin() + 9);
+			v1.erase(v1.begin());
+			EXAM_CHECK(16 == v1.size());
+			EXAM_CHECK(2 == v1[4].m_value);
+			EXAM_CHECK(3 == v1[5].m_value);
+			EXAM_CHECK(9 == v1[15].m_value);
+			EXAM_CHECK(5 == (*ip5).m_value);
+			EXAM_CHECK(7 == ip5.position());
+
+			v1.rollback(sp1);
+			v1.release(sp1);
+			EXAM_CHECK(10 == v1.size());
+			for (int i = 0; i < 10; i += 1) {
+				EXAM_CHECK(i == v1[i].m_value);
+				EXAM_CHECK(v1[i].is_intact());
+			}
+			EXAM_CHECK(5 == ip5.position());
+
+			/* insertions where the inserted elements, the elements after them, or both, are too many to be set aside */
+			msevector<CRelocatableRecord> v2;
+			std::vector<int> expected2;
+			for (int i = 0; i < 300; i += 1) { v2.push_back(CRelocatableRecord(i)); expected2.push_back(i); }
+			v2.insert(v2.end() - 10, 200, CRelocatableRecord(-1));
+			expected2.insert(expected2.end() - 10, 200, -1);
+			v2.insert(v2.begin() + 5, 200, CRelocatableRecord(-2));
+			expected2.insert(expected2.begin() + 5, 200, -2);
+			std::vector<CRelocatableRecord> source2;
+			for (int i = 0; i < 100; i += 1) { source2.push_back(CRelocatableRecord(1000 + i)); expected2.insert(expected2.begin() + 50 + i, 1000 + i); }
+			v2.insert(v2.begin() + 50, source2.begin(), source2.end());
+			EXAM_CHECK(expected2.size() == v2.size());
+			for (size_t i = 0; v2.size() > i; i += 1) {
+				EXAM_CHECK((expected2[i] == v2[i].m_value) && (v2[i].is_intact()));
+			}
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m23()
+		{
+			/* Exercises resize_default_init() and append_uninitialized(). */
+			msevector<unsigned char, msevector_default_init_allocator<unsigned char> > v1;
+			v1.push_back(7);
+			auto end_ip = v1.iend();
+			auto ip0 = v1.ibegin();
+			auto sp1 = v1.savepoint();
+
+			v1.resize_default_init(1000);
+			EXAM_CHECK(1000 == v1.size());
+			EXAM_CHECK(v1.iend() == end_ip);
+			EXAM_CHECK(7 == *ip0);
+
+			auto span1 = v1.append_uninitialized(24);
+			EXAM_CHECK(1024 == v1.size());
+			EXAM_CHECK(24 == span1.size());
+			EXAM_CHECK(1000 == span1.position());
+			for (size_t i = 0; span1.size() > i; i += 1) { span1[i] = (unsigned char)(i); }
+			std::memcpy(span1.data(), "abc", 3);
+			EXAM_CHECK('c' == v1[1002]);
+			EXAM_CHECK(23 == v1[1023]);
+			EXAM_CHECK(v1.iend() == end_ip);
+			try {
+				span1[24] = 0;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			/* the span doesn't allow access to elements that have since been removed */
+			v1.resize_default_init(1010);
+			EXAM_CHECK(1010 == v1.size());
+			span1[9] = 1;
+			try {
+				span1[10] = 0;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			try {
+				span1.data();
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			v1.rollback(sp1);
+			v1.release(sp1);
+			EXAM_CHECK(1 == v1.size());
+			EXAM_CHECK(v1.iend() == end_ip);
+
+			/* with std::allocator the new elements are value initialized */
+			msevector<int> v2;
+			v2.resize_default_init(100);
+			auto span2 = v2.append_uninitialized(10);
+			EXAM_CHECK(110 == v2.size());
+			EXAM_CHECK((0 == v2[50]) && (0 == span2[9]));
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m24()
+		{
+			/* Exercises the (allocation free) move operations of msevector, mstd::vector and ivector. */
+#ifndef MSVC2010_COMPATIBILE
+			EXAM_CHECK(std::is_nothrow_move_constructible<msevector<int> >::value);
+			EXAM_CHECK(std::is_nothrow_move_assignable<msevector<int> >::value);
+			EXAM_CHECK(std::is_nothrow_move_constructible<mstd::vector<int> >::value);
+			EXAM_CHECK(std::is_nothrow_move_assignable<mstd::vector<int> >::value);
+			EXAM_CHECK(std::is_nothrow_move_constructible<ivector<int> >::value);
+			EXAM_CHECK(std::is_nothrow_move_assignable<ivector<int> >::value);
+#endif /*MSVC2010_COMPATIBILE*/
+
+			msevector<int> v1;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(i); }
+			const int* data_ptr = v1.data();
+			auto ip3 = v1.ibegin() + 3;
+			auto sp1 = v1.savepoint();
+			msevector<int> v2(std::move(v1));
+			EXAM_CHECK(v2.data() == data_ptr);
+			EXAM_CHECK((10 == v2.size()) && (0 == v1.size()));
+			/* the moved-from vector's ipointers become end markers and its savepoints are discarded */
+			EXAM_CHECK(ip3 == v1.iend());
+			try {
+				v1.rollback(sp1);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			v1.push_back(20);
+			EXAM_CHECK((1 == v1.size()) && (20 == v1[0]));
+
+			msevector<int> v3(5, 7);
+			auto ip4 = v3.ibegin() + 4;
+			v3 = std::move(v2);
+			EXAM_CHECK(v3.data() == data_ptr);
+			EXAM_CHECK((10 == v3.size()) && (9 == v3.back()));
+			EXAM_CHECK(ip4 == v3.iend());
+			v3 = std::move(v3);
+			EXAM_CHECK(10 == v3.size());
+
+			/* (resetting the moved-from vector's ipointers and iranges doesn't allocate) */
+			msevector<int> v4(v3);
+			msevector<msevector<int>::ipointer> ips;
+			for (int i = 0; i < 10; i += 1) { ips.push_back(v4.ibegin() + i); }
+			msevector<int>::irange r1(v4, 2, 6);
+			msevector<int>::irange r2(v4, 4, 4);
+			msevector<int> v5(std::move(v4));
+			EXAM_CHECK((ips[0] == v4.iend()) && (ips[9] == v4.iend()) && r1.empty() && r2.empty());
+			v4.push_back(1);
+			v4.push_back(2);
+			EXAM_CHECK(r1.empty() && (ips[5].points_to_end_marker()) && (2 == *(v4.ibegin() + 1)));
+			r1.set_range(0, 2);
+			EXAM_CHECK((2 == r1.size()) && (1 == r1.front()));
+
+			/* std::vector moves (rather than copies) the elements when it reallocates */
+			std::vector<msevector<int> > vv1(1, v3);
+			const int* data_ptr2 = vv1[0].data();
+			vv1.resize(vv1.capacity() + 1);
+			EXAM_CHECK(vv1[0].data() == data_ptr2);
+
+			mstd::vector<int> mv1(v3);
+			auto mv1_it2 = mv1.begin() + 2;
+			mstd::vector<int> mv2(std::move(mv1));
+			EXAM_CHECK(10 == mv2.size());
+			/* the iterators follow the elements */
+			EXAM_CHECK(2 == *mv1_it2);
+			*mv1_it2 = 12;
+			EXAM_CHECK(12 == mv2[2]);
+			EXAM_CHECK(mv1.empty());
+			mv1.push_back(1);
+			EXAM_CHECK((1 == mv1.size()) && (10 == mv2.size()));
+			mstd::vector<int> mv3;
+			mv3 = std::move(mv2);
+			EXAM_CHECK((10 == mv3.size()) && (12 == mv3[2]) && (0 == mv2.size()));
+			/* (the const member functions of a moved-from vector treat it as empty, without allocating a new msevector) */
+			const mstd::vector<int>& mv2_cref = mv2;
+			EXAM_CHECK(mv2_cref.empty() && (0 == mv2_cref.size()) && (mv2_cref.begin() == mv2_cref.end()) && (mv2_cref.cbegin() == mv2_cref.cend()));
+			EXAM_CHECK((mv2_cref == mstd::vector<int>()) && (mv2_cref < mv3) && (mv2_cref.msevector().empty()));
+			try {
+				mv2_cref.at(0);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			mstd::vector<int> mv4(mv2_cref);
+			mv4.push_back(3);
+			mv2.push_back(4);
+			EXAM_CHECK((1 == mv4.size()) && (3 == mv4[0]) && (1 == mv2.size()) && (4 == mv2[0]));
+
+			ivector<int> iv1(v3);
+			ivector<int>::ipointer iv1_ip5(iv1);
+			iv1_ip5.advance(5);
+			ivector<int> iv2;
+			iv2 = std::move(iv1);
+			EXAM_CHECK(5 == *iv1_ip5);
+			iv2.erase(iv2.begin());
+			EXAM_CHECK((5 == *iv1_ip5) && (4 == iv1_ip5.position()));
+			ivector<int> iv3(std::move(iv2));
+			EXAM_CHECK((9 == iv3.size()) && iv1.empty() && iv2.empty());
+			const ivector<int>& iv2_cref = iv2;
+			EXAM_CHECK((0 == iv2_cref.size()) && (iv2_cref == ivector<int>()) && (iv2_cref < iv3) && (iv2_cref.cbegin() == iv2_cref.cend()));
+			try {
+				iv2_cref[0];
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m25()
+		{
+			/* Exercises iranges (tracked ranges). */
+			msevector<int> v1;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(i); }
+			msevector<int>::irange r1 = v1.make_irange(3, 7);
+			msevector<int>::irange r2(v1, 5, 5);
+			EXAM_CHECK((4 == r1.size()) && (3 == r1.front()) && (6 == r1.back()));
+
+			/* insertions inside the range grow it, insertions at either end don't */
+			v1.insert(v1.begin() + 4, 100);
+			v1.insert(v1.begin() + 3, 101);
+			v1.insert(v1.begin() + 9, 102);
+			EXAM_CHECK((4 == r1.begin_position()) && (9 == r1.end_position()));
+			EXAM_CHECK((3 == r1[0]) && (100 == r1[1]) && (6 == r1.back()));
+			EXAM_CHECK(r2.empty() && (7 == r2.begin_position()));
+			int sum = 0;
+			for (auto iter = r1.begin(); r1.end() != iter; ++iter) { sum += (*iter); }
+			EXAM_CHECK(3 + 100 + 4 + 5 + 6 == sum);
+
+			/* erasures shrink the range */
+			v1.erase(v1.begin() + 2, v1.begin() + 6);
+			EXAM_CHECK((2 == r1.begin_position()) && (5 == r1.end_position()));
+			EXAM_CHECK((4 == r1[0]) && (6 == r1[2]));
+			try {
+				r1[3];
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			v1.erase(v1.begin(), v1.begin() + 8);
+			EXAM_CHECK(r1.empty() && (0 == r1.begin_position()));
+			EXAM_CHECK(r2.empty() && (0 == r2.begin_position()));
+
+			msevector<int> v2;
+			for (int i = 0; i < 20; i += 1) { v2.push_back(i); }
+			msevector<int>::irange r3(v2, 5, 15);
+			auto ip12 = v2.ibegin() + 12;
+			v2.erase_if([](int x) { return (0 == (x % 2)); });
+			EXAM_CHECK((2 == r3.begin_position()) && (7 == r3.end_position()));
+			EXAM_CHECK((5 == r3.front()) && (13 == r3.back()) && ip12.points_to_end_marker());
+
+			/* sort() leaves the range's positions alone */
+			std::reverse(v2.begin(), v2.end());
+			v2.sort();
+			EXAM_CHECK((2 == r3.begin_position()) && (7 == r3.end_position()));
+
+			/* savepoint rollbacks replay through the normal insert()/erase() paths */
+			auto sp1 = v2.savepoint();
+			v2.erase(v2.begin() + 3);
+			v2.insert(v2.begin() + 4, 3, 0);
+			EXAM_CHECK((2 == r3.begin_position()) && (9 == r3.end_position()));
+			v2.rollback(sp1);
+			v2.release(sp1);
+			EXAM_CHECK((2 == r3.begin_position()) && (7 == r3.end_position()));
+
+			msevector<int>::irange r4 = r3;
+			r4.set_range(0, 1);
+			EXAM_CHECK((1 == r4.size()) && (7 == r3.end_position()));
+			try {
+				r4.set_range(2, 100);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			v2.clear();
+			EXAM_CHECK(r3.empty() && r4.empty());
+
+			msevector<int> v3;
+			for (int i = 0; i < 30; i += 1) { v3.push_back(i); }
+			msevector<int>::irange ra(v3, 2, 4), rb(v3, 3, 10), rc(v3, 4, 6), rd(v3, 20, 25);
+			v3.erase(v3.begin() + 3, v3.begin() + 6);
+			EXAM_CHECK((2 == ra.begin_position()) && (3 == ra.end_position()));
+			EXAM_CHECK((3 == rb.begin_position()) && (7 == rb.end_position()));
+			EXAM_CHECK(rc.empty() && (3 == rc.begin_position()));
+			EXAM_CHECK((17 == rd.begin_position()) && (22 == rd.end_position()));
+			v3.insert(v3.begin() + 3, 100);
+			EXAM_CHECK((2 == ra.begin_position()) && (3 == ra.end_position()));
+			EXAM_CHECK((4 == rb.begin_position()) && (8 == rb.end_position()) && (6 == rb.front()));
+			EXAM_CHECK(rc.empty() && (4 == rc.begin_position()));
+			EXAM_CHECK((18 == rd.begin_position()) && (23 == rd.end_position()) && (20 == rd.front()));
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m26()
+		{
+			/* Exercises weak_ipointers. */
+			msevector<int> v1;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(i); }
+			msevector<int>::weak_ipointer wp1 = v1.make_weak_ipointer(4);
+			msevector<int>::weak_ipointer wp2(v1, 10);
+			EXAM_CHECK(wp1.is_valid() && wp1.points_to_an_item() && (4 == *wp1));
+			EXAM_CHECK(wp2.points_to_end_marker());
+			try {
+				*wp2;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			try {
+				msevector<int>::weak_ipointer wp3(v1, 11);
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			/* element assignments and reallocations don't make it stale */
+			v1[4] = 40;
+			v1.reserve(1000);
+			v1.shrink_to_fit();
+			EXAM_CHECK(wp1.is_valid() && (40 == *wp1));
+			*wp1 = 4;
+
+			/* insertions, removals and reorderings do */
+			v1.push_back(10);
+			EXAM_CHECK(wp1.is_stale() && wp2.is_stale() && (!wp1.points_to_an_item()) && (4 == wp1.position()));
+			try {
+				*wp1;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			try {
+				auto ip = wp1.to_ipointer();
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			wp1.set_position(4);
+			EXAM_CHECK(wp1.is_valid() && (4 == *wp1));
+			v1.sort();
+			EXAM_CHECK(wp1.is_stale());
+			wp1.set_position(4);
+			v1.erase_if([](int x) { return (100 == x); });
+			EXAM_CHECK(wp1.is_valid());
+			v1.erase_if([](int x) { return (9 == x); });
+			EXAM_CHECK(wp1.is_stale());
+			wp1.set_position(4);
+			v1.splice(0, v1, 8, 10);
+			EXAM_CHECK(wp1.is_stale());
+			wp1.set_position(4);
+			std::vector<size_t> identity;
+			for (size_t i = 0; v1.size() > i; i += 1) { identity.push_back(i); }
+			v1.apply_permutation(identity);
+			EXAM_CHECK(wp1.is_stale());
+
+			/* a weak_ipointer can be made from, and converted to, a registered ipointer */
+			msevector<int>::ipointer ip1(v1);
+			ip1.advance(3);
+			msevector<int>::weak_ipointer wp4(ip1);
+			EXAM_CHECK(wp4.is_valid() && (3 == wp4.position()) && ((*ip1) == (*wp4)));
+			auto ip2 = wp4.to_ipointer();
+			v1.insert(v1.begin(), 100);
+			EXAM_CHECK(wp4.is_stale() && (4 == ip2.position()) && ((*ip1) == (*ip2)));
+
+			/* swaps and moves make the weak_ipointers of both vectors stale */
+			msevector<int> v2(3, 7);
+			msevector<int>::weak_ipointer wp5(v2, 1);
+			wp4.set_position(1);
+			v1.swap(v2);
+			EXAM_CHECK(wp4.is_stale() && wp5.is_stale());
+			wp4.set_position(1);
+			wp5.set_position(1);
+			msevector<int> v3(std::move(v1));
+			EXAM_CHECK(wp4.is_stale() && wp5.is_valid());
+			v2.clear();
+			EXAM_CHECK(wp5.is_stale());
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m27()
+		{
+			/* Exercises mstd::vector iterators (which hold their safe iterators by value). */
+			mstd::vector<int> v1;
+			for (int i = 0; i < 10; i += 1) { v1.push_back(i); }
+			int sum = 0;
+			for (auto& item : v1) { sum += item; }
+			EXAM_CHECK(45 == sum);
+
+			mstd::vector<int>::iterator it1 = v1.begin();
+			mstd::vector<int>::iterator it2 = it1;
+			++it2;
+			EXAM_CHECK((0 == *it1) && (1 == *it2) && (1 == (it2 - it1)));
+			mstd::vector<int>::const_iterator cit1 = it2;
+			EXAM_CHECK((1 == *cit1) && (1 == cit1.position()));
+			it2++;
+			EXAM_CHECK((2 == *it2) && (1 == *cit1));
+
+			/* assignment takes the other iterator's vector along with its position */
+			mstd::vector<int>::iterator it3;
+			{
+				mstd::vector<int> v2(5, 7);
+				it3 = v2.begin();
+				it3 += 2;
+				it1 = it3;
+			}
+			EXAM_CHECK((7 == *it3) && (7 == *it1) && (2 == it1.position()));
+			it1 = v1.end();
+			EXAM_CHECK(it1.points_to_end_marker() && (10 == (it1 - v1.begin())));
+			mstd::vector<int>::const_iterator cit2;
+			cit2 = v1.cbegin();
+			cit2 = v1.cend();
+			EXAM_CHECK(cit2.points_to_end_marker());
+			try {
+				*it1;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m28()
+		{
+			/* Exercises the (intrusively) reference counted storage shared by mstd::vectors and their iterators. */
+			typedef TRefCountedMsevectorPtr<msevector<int> > ptr_type;
+			ptr_type p1(msevector<int>(3, 5));
+			EXAM_CHECK((1 == p1.use_count()) && (3 == p1->size()) && (5 == (*p1)[2]));
+			{
+				ptr_type p2 = p1;
+				ptr_type p3;
+				EXAM_CHECK(!p3);
+				p3 = p2;
+				EXAM_CHECK((3 == p1.use_count()) && (p3 == p1) && (p1.get() == p3.get()));
+				p3 = p3;
+				EXAM_CHECK(3 == p1.use_count());
+				ptr_type p4(std::move(p3));
+				EXAM_CHECK((3 == p1.use_count()) && (!p3) && (p4 == p1));
+				p4.reset();
+				EXAM_CHECK(2 == p1.use_count());
+			}
+			EXAM_CHECK(1 == p1.use_count());
+			p1 = ptr_type(msevector<int>(1, 6));
+			EXAM_CHECK((1 == p1.use_count()) && (6 == p1->front()));
+
+			/* an iterator keeps the (cleared) vector's elements alive */
+			typedef mstd::vector<int> vint_type;
+			mstd::vector<vint_type> vvi;
+			vvi.push_back(vint_type(3, 7));
+			vint_type::iterator it1 = vvi[0].begin();
+			it1 += 2;
+			vvi.clear();
+			EXAM_CHECK(7 == *it1);
+			vint_type vi2(2, 8);
+			it1 = vi2.begin();
+			EXAM_CHECK(8 == *it1);
+			vint_type vi3(vi2);
+			vi3[0] = 9;
+			EXAM_CHECK((8 == *it1) && (9 == vi3.front()));
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m29()
+		{
+			/* Exercises the single threaded (non-atomic) reference count policy. */
+			typedef mstd::vector<int, std::allocator<int>, msevector_single_threaded_reference_count> st_vector_type;
+			st_vector_type v1(5, 3);
+			st_vector_type::iterator it1 = v1.begin();
+			st_vector_type::iterator it2 = it1;
+			it2++;
+			EXAM_CHECK((3 == *it2) && (1 == (it2 - it1)));
+			int sum = 0;
+			for (auto& item : v1) { sum += item; }
+			EXAM_CHECK(15 == sum);
+			{
+				st_vector_type v2(std::move(v1));
+				v1 = v2;
+				EXAM_CHECK((v1 == v2) && (!(v1 != v2)) && (v1 <= v2));
+				it1 = v2.end();
+			}
+			/* the iterator keeps the moved-to vector's elements alive */
+			it1 -= 1;
+			EXAM_CHECK(3 == *it1);
+
+			typedef ivector<int, std::allocator<int>, msevector_single_threaded_reference_count> st_ivector_type;
+			st_ivector_type iv1(4, 2);
+			st_ivector_type::ipointer ip1 = iv1.begin();
+			ip1 += 3;
+			st_ivector_type::cipointer cip1 = ip1;
+			iv1.insert_before(iv1.begin(), 1);
+			EXAM_CHECK((2 == *ip1) && (4 == ip1.position()) && (4 == cip1.position()));
+			st_ivector_type iv2(iv1);
+			EXAM_CHECK((iv1 == iv2) && (5 == iv2.size()));
+
+			TRefCountedMsevectorPtr<msevector<int>, msevector_single_threaded_reference_count> p1(msevector<int>(2, 1));
+			auto p2 = p1;
+			EXAM_CHECK((2 == p1.use_count()) && (p1 == p2));
+			p2.reset();
+			EXAM_CHECK(1 == p1.use_count());
+
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m30()
+		{
+			/* Exercises moving (i)pointers and the ivector mutators that reuse the position argument's registry slot. */
+			msevector<int> v1;
+			for (int i = 0; i < 6; i += 1) { v1.push_back(i); }
+			msevector<int>::ipointer ip1(v1);
+			ip1 += 2;
+			msevector<int>::ipointer ip2(std::move(ip1));
+			EXAM_CHECK((2 == *ip2) && (0 == *ip1));
+			v1.insert(v1.begin(), 10);
+			EXAM_CHECK((2 == *ip2) && (3 == ip2.position()) && (0 == *ip1));
+			msevector<int>::cipointer cip1(v1);
+			cip1 += 5;
+			msevector<int>::cipointer cip2(std::move(cip1));
+			v1.erase(v1.begin());
+			EXAM_CHECK((4 == *cip2) && (0 == cip1.position()));
+
+			ivector<int> iv1;
+			for (int i = 0; i < 6; i += 1) { iv1.push_back(i); }
+			ivector<int>::ipointer ip3 = iv1.begin();
+			ip3 += 2;
+			ivector<int>::ipointer ip4 = iv1.insert_before(ip3, 2, 7);
+			EXAM_CHECK((7 == *ip4) && (2 == ip4.position()) && (2 == *ip3) && (4 == ip3.position()));
+			ivector<int>::ipointer ip5 = iv1.insert_before(std::move(ip4), 8);
+			EXAM_CHECK((8 == *ip5) && (2 == ip5.position()) && (2 == *ip3) && (5 == ip3.position()));
+			ivector<int>::ipointer ip6 = iv1.erase(std::move(ip5));
+			EXAM_CHECK((7 == *ip6) && (2 == ip6.position()) && (2 == *ip3) && (4 == ip3.position()));
+			ivector<int>::ipointer ip7 = iv1.erase(ip6);
+			EXAM_CHECK((7 == *ip7) && (2 == ip7.position()) && (3 == ip3.position()));
+			ivector<int>::ipointer ip8 = iv1.erase_inclusive(ip7, ip3);
+			EXAM_CHECK((3 == *ip8) && (2 == ip8.position()));
+			EXAM_CHECK((5 == iv1.size()) && (0 == iv1[0]) && (1 == iv1[1]) && (3 == iv1[2]));
+			ivector<int> iv2(3, 9);
+			ivector<int>::ipointer ip9 = iv1.insert_before_inclusive(iv1.begin(), iv2.cbegin(), iv2.cbegin());
+			EXAM_CHECK((9 == *ip9) && (6 == iv1.size()) && (3 == ip8.position()));
+
+			ivector<int>::cipointer cip3 = iv1.cend();
+			EXAM_CHECK(cip3.points_to_end_marker());
+			{
+				ivector<int>::ipointer ip10 = iv1.begin();
+				ivector<int>::ipointer ip11(std::move(ip10));
+				EXAM_CHECK(9 == *ip11);
+			}
+			return EXAM_RESULT;
+		}
+
+		CInt msevec_test_m31()
+		{
+			/* Exercises ss iterators' validation against the vector's buffer generation. */
+			msevector<int> v1;
+			for (int i = 0; i < 4; i += 1) { v1.push_back(i); }
+			msevector<int>::ss_iterator_type it1 = v1.ss_begin();
+			it1 += 2;
+			msevector<int>::ss_const_iterator_type cit1 = v1.ss_cbegin();
+			v1.reserve(1000);
+			for (int i = 4; i < 100; i += 1) { v1.push_back(i); }
+			/* stale iterators are resynced (from their positions) when they're next used */
+			EXAM_CHECK((2 == *it1) && (0 == *cit1));
+			msevector<int>::ss_iterator_type it2 = v1.ss_end();
+			EXAM_CHECK((98 == (it2 - it1)) && (it2.points_to_end_marker()));
+			v1.shrink_to_fit();
+			it2 -= 1;
+			EXAM_CHECK(99 == (*it2));
+			auto it3 = v1.insert(it1, 50);
+			EXAM_CHECK((50 == *it3) && (50 == v1[2]) && (2 == v1[3]) && (101 == v1.size()));
+			msevector<int>::ss_const_iterator_type cit2 = it3;
+			EXAM_CHECK((2 == cit2.position()) && (50 == *cit2));
+
+			/* iterators positioned beyond the (new) end of the vector throw rather than access a stale buffer */
+			v1.resize(2);
+			try {
+				*it2;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+			EXAM_CHECK((it1.points_to_end_marker()) && (1 == *(it1 - 1)));
+			msevector<int>::ss_iterator_type it4;
+			try {
+				*it4;
+				EXAM_CHECK(false);
+			}
+			catch (...) {}
+
+			mstd::vector<int> v2(3, 7);
+			mstd::vector<int>::iterator it5 = v2.begin();
+			for (int i = 0; i < 100; i += 1) { v2.push_back(i); }
+			*it5 = 8;
+			EXAM_CHECK((8 == v2.front()) && (103 == (v2.end() - it5)));
+			v2.clear();
+			EXAM_CHECK(it5 == v2.end());
+
+			/* (The first ss iterator allocates just the buffer generation. The ipointer registry is allocated separately,
+			later, and the ss iterators obtained before it stay valid.) */
+			msevector<int> v3;
+			for (int i = 0; i < 10; i += 1) { v3.push_back(i); }
+			msevector<int>::ss_iterator_type it6 = v3.ss_begin();
+			it6 += 3;
+			msevector<int>::ipointer ip1(v3);
+			ip1 += 3;
+			v3.insert(v3.begin(), 100);
+			EXAM_CHECK((2 == *it6) && (4 == ip1.position()) && (3 == *ip1));
+
+#ifndef MSVC2010_COMPATIBILE
+			/* Obtaining the first ss iterators of a const vector from multiple threads at once is safe. */
+			const msevector<int> v4(1000, 1);
+			std::atomic<int> total(0);
+			std::vector<std::thread> threads;
+			for (int i = 0; i < 4; i += 1) {
+				threads.push_back(std::thread([&v4, &total]() {
+					int sum = 0;
+					for (auto it = v4.ss_cbegin(); it != v4.ss_cend(); ++it) { sum += *it; }
+					total += sum;
+				}));
+			}
+			for (auto& thread_ref : threads) { thread_ref.join(); }
+			EXAM_CHECK(4000 == total);
+#endif /*!MSVC2010_COMPATIBILE*/
+
+			return EXAM_RESULT;
+		}
 
 		//int EXAM_IMPL(vector_test::vec_test_1)
 		CInt msevec_test_i1()